@@ -12,46 +12,110 @@
 #include "meta_words_playback_renderer.h"
 #include "meta_words_serde.h"
 #include "preferences_serde.h"
+#include "whipser_cpp_wrapper.h"
 
 namespace mam {
 
 //------------------------------------------------------------------------
-static auto collect_meta_words_serde_dataset(
+static constexpr auto PREFETCH_TIMER_INTERVAL_MS = Steinberg::uint32(50);
+static constexpr size_t NUM_PREFETCH_THREADS      = 2;
+
+//------------------------------------------------------------------------
+static auto collect_encoded_audio_sources(
     const ARA::PlugIn::StoreObjectsFilter* filter,
-    meta_words::serde::Archive& archive) -> meta_words::serde::Archive&
+    ARADocumentController::EncodedSources& encoded_sources)
+    -> meta_words::serde::EncodedAudioSources
 {
     using AudioSource = ARADocumentController::AudioSource;
 
-    meta_words::serde::Archive meta_words_serde_dataset;
-    auto audio_sources = filter->getAudioSourcesToStore<AudioSource>();
-    for (const auto& as : audio_sources)
+    meta_words::serde::EncodedAudioSources audio_sources;
+    auto audio_sources_to_store = filter->getAudioSourcesToStore<AudioSource>();
+    for (const auto& as : audio_sources_to_store)
     {
-        const auto persistent_id = as->getPersistentID();
-        const auto mdw           = as->get_meta_words();
+        // Only words which changed since the last store are encoded again
+        auto& encoded = encoded_sources[as->get_id()];
+        if (!encoded.words || encoded.generation != as->get_generation())
+        {
+            const auto& store  = as->get_word_store();
+            encoded.generation = as->get_generation();
+            encoded.words      = meta_words::serde::encode(
+                store ? store->to_meta_words() : meta_words::MetaWords{});
+        }
 
-        archive.audio_sources.push_back({persistent_id, mdw});
+        audio_sources.push_back({as->getPersistentID(), encoded.words});
     }
 
-    return archive;
+    return audio_sources;
+}
+
+//------------------------------------------------------------------------
+static auto apply_meta_words_serde_audio_source(
+    const ARA::PlugIn::RestoreObjectsFilter* filter,
+    meta_words::serde::AudioSource&& audio_source) -> void
+{
+    using AudioSource = ARADocumentController::AudioSource;
+
+    auto* restored = filter->getAudioSourceToRestoreStateWithID(
+        static_cast<ARA::ARAPersistentID>(audio_source.persistent_id.data()));
+
+    if (auto as = dynamic_cast<AudioSource*>(restored))
+        as->set_meta_words(std::move(audio_source.words));
 }
 
 //------------------------------------------------------------------------
-static auto apply_meta_words_serde_dataset(
+static auto apply_meta_words_serde_encoded_audio_source(
     const ARA::PlugIn::RestoreObjectsFilter* filter,
-    const meta_words::serde::Archive& archive) -> void
+    meta_words::serde::EncodedAudioSource&& audio_source,
+    ARADocumentController::EncodedSources& encoded_sources) -> void
 {
     using AudioSource = ARADocumentController::AudioSource;
 
-    for (const auto& el : archive.audio_sources)
+    auto* restored = filter->getAudioSourceToRestoreStateWithID(
+        static_cast<ARA::ARAPersistentID>(audio_source.persistent_id.data()));
+
+    // The block is stored again as it is, until the words change
+    if (auto as = dynamic_cast<AudioSource*>(restored))
     {
-        auto audio_sources = filter->getAudioSourceToRestoreStateWithID(
-            static_cast<ARA::ARAPersistentID>(el.persistent_id.data()));
+        as->set_encoded_words(audio_source.words);
+        encoded_sources[as->get_id()] = {as->get_generation(),
+                                         std::move(audio_source.words)};
+    }
+}
 
-        if (auto as = dynamic_cast<AudioSource*>(audio_sources))
-        {
-            as->set_meta_words(el.words);
-        }
+//------------------------------------------------------------------------
+static auto collect_timeline_entries(
+    const ARADocumentController::PlaybackRegion& region)
+    -> TimelineIndex::Entries
+{
+    const auto words          = region.get_region_words();
+    const auto project_offset = region.getStartInPlaybackTime() -
+                                region.getStartInAudioModificationTime();
+
+    TimelineIndex::Entries entries;
+    entries.reserve(words.size());
+    for (auto i = words.first(); i < words.last(); i++)
+    {
+        if (words.is_clipped_by_region(i))
+            continue;
+
+        const auto begin = words.begin(i) + project_offset;
+        entries.push_back({begin, begin + words.duration(i), region.get_id(),
+                           static_cast<Index>(i)});
     }
+
+    return entries;
+}
+
+//------------------------------------------------------------------------
+static auto has_pending_words(
+    const ARADocumentController::PlaybackRegion& region) -> bool
+{
+    // Encoded words are decoded in the background, the indexes of the
+    // region follow in on_prefetch_timer
+    const auto* source =
+        region.getAudioModification()
+            ->getAudioSource<ARADocumentController::AudioSource>();
+    return source->has_encoded_words() || source->is_prefetching();
 }
 
 //------------------------------------------------------------------------
@@ -88,6 +152,8 @@ ARADocumentController::ARADocumentController(
     const ARA::PlugIn::PlugInEntry* entry,
     const ARA::ARADocumentControllerHostInstance* instance) noexcept
 : ARA::PlugIn::DocumentController(entry, instance)
+, search_index(whisper_cpp::get_language())
+, prefetch_pool(NUM_PREFETCH_THREADS)
 {
     region_order_manager.start_in_playback_time_func = [this](Id id) {
         const auto opt_region = find_playback_region(id);
@@ -103,16 +169,45 @@ bool ARADocumentController::doRestoreObjectsFromArchive(
     ARA::PlugIn::HostArchiveReader* archiveReader,
     const ARA::PlugIn::RestoreObjectsFilter* filter) noexcept
 {
-    // Retore archive
+    // Restore archive chunk by chunk, every audio source is applied as soon
+    // as it is read
     const auto archive_size = archiveReader->getArchiveSize();
-    StringType deserialized;
-    deserialized.resize(archive_size);
-    bool result = archiveReader->readBytesFromArchive(
-        0, archive_size, (ARA::ARAByte*)deserialized.data());
-
-    meta_words::serde::Archive archive;
-    meta_words::serde::deserialize(deserialized, archive);
-    apply_meta_words_serde_dataset(filter, archive);
+    const auto version      = meta_words::serde::read_chunked(
+        archive_size,
+        [&](size_t position, size_t size, char* data) {
+            return archiveReader->readBytesFromArchive(
+                position, size, reinterpret_cast<ARA::ARAByte*>(data));
+        },
+        [&](meta_words::serde::AudioSource&& audio_source) {
+            apply_meta_words_serde_audio_source(filter,
+                                                std::move(audio_source));
+        },
+        [&](meta_words::serde::EncodedAudioSource&& audio_source) {
+            apply_meta_words_serde_encoded_audio_source(
+                filter, std::move(audio_source), encoded_sources);
+        });
+
+    const bool result = version.has_value();
+
+    // Words still encoded are decoded in the background, the indexes follow
+    // as soon as they are ready
+    for (auto* source : getDocument()->getAudioSources<AudioSource>())
+    {
+        if (source->has_encoded_words())
+            prefetch_words(*source);
+        else
+            update_search_index(*source);
+    }
+
+    for (const auto& region : playback_regions)
+    {
+        if (has_pending_words(*region.second))
+            continue;
+
+        update_timeline_index(*region.second);
+        update_frequency_index(*region.second);
+    }
+
     return result;
 }
 
@@ -122,13 +217,13 @@ bool ARADocumentController::doStoreObjectsToArchive(
     const ARA::PlugIn::StoreObjectsFilter* filter) noexcept
 {
     // Store archive
-    meta_words::serde::Archive archive;
-    archive = collect_meta_words_serde_dataset(filter, archive);
+    auto audio_sources = collect_encoded_audio_sources(filter, encoded_sources);
+    const auto write = [&](size_t position, size_t size, const char* data) {
+        return archiveWriter->writeBytesToArchive(
+            position, size, reinterpret_cast<const ARA::ARAByte*>(data));
+    };
 
-    StringType serialized;
-    meta_words::serde::serialize(archive, serialized);
-    return archiveWriter->writeBytesToArchive(0, serialized.length(),
-                                              (ARA::ARAByte*)serialized.data());
+    return meta_words::serde::write_chunked(std::move(audio_sources), write);
 }
 
 //------------------------------------------------------------------------
@@ -193,6 +288,20 @@ ARA::PlugIn::AudioSource* ARADocumentController::doCreateAudioSource(
     return nullptr;
 }
 
+//------------------------------------------------------------------------
+void ARADocumentController::doDestroyAudioSource(
+    ARA::PlugIn::AudioSource* audioSource) noexcept
+{
+    if (auto* as = dynamic_cast<AudioSource*>(audioSource))
+    {
+        search_index.remove_source(as->get_id());
+        encoded_sources.erase(as->get_id());
+        prefetching_sources.erase(as->get_id());
+    }
+
+    ARA::PlugIn::DocumentController::doDestroyAudioSource(audioSource);
+}
+
 //------------------------------------------------------------------------
 ARA::PlugIn::AudioModification*
 ARADocumentController::doCreateAudioModification(
@@ -264,6 +373,12 @@ void ARADocumentController::didUpdatePlaybackRegionProperties(
 
     if (auto* pbr = dynamic_cast<PlaybackRegion*>(playbackRegion))
     {
+        if (!has_pending_words(*pbr))
+        {
+            update_timeline_index(*pbr);
+            update_frequency_index(*pbr);
+        }
+
         auto obj = playback_region_observers.find(pbr->get_id());
         if (obj != playback_region_observers.end())
             obj->second();
@@ -357,6 +472,18 @@ void ARADocumentController::on_add_playback_region(PlaybackRegion* region)
     playback_regions.insert({region->get_id(), region});
     region_order_manager.push_back(region->get_id());
 
+    // Its audio source might have been restored before it had any region
+    auto* source =
+        region->getAudioModification()->getAudioSource<AudioSource>();
+    if (source->has_encoded_words())
+        prefetch_words(*source);
+
+    if (!has_pending_words(*region))
+    {
+        update_timeline_index(*region);
+        update_frequency_index(*region);
+    }
+
     playback_region_lifetimes_subject(
         {RegionLifetimeEventData::Event::HasBeenAdded, region->get_id()});
 }
@@ -369,29 +496,113 @@ void ARADocumentController::on_remove_playback_region(Id id)
 
     region_order_manager.remove(id);
     playback_regions.erase(id);
+    timeline_index.remove_region(id);
+    frequency_index.remove_region(id);
+}
+
+//------------------------------------------------------------------------
+void ARADocumentController::update_timeline_index(const PlaybackRegion& region)
+{
+    timeline_index.update_region(region.get_id(),
+                                 collect_timeline_entries(region));
+}
+
+//------------------------------------------------------------------------
+void ARADocumentController::update_search_index(const AudioSource& audio_source)
+{
+    search_index.update_source(audio_source.get_id(),
+                               audio_source.get_word_store());
+}
+
+//------------------------------------------------------------------------
+void ARADocumentController::update_frequency_index(const PlaybackRegion& region)
+{
+    const auto snapshot = search_index.get_snapshot();
+    const auto* source_index =
+        snapshot.find_source(region.get_audio_source_id());
+
+    frequency_index.update_region(
+        region.get_id(),
+        FrequencyIndex::count_terms(region.get_region_words(), source_index));
+}
+
+//------------------------------------------------------------------------
+void ARADocumentController::prefetch_words(AudioSource& audio_source)
+{
+    // Audio sources without playback regions are not shown anywhere, they
+    // are decoded on first access only
+    bool has_regions = false;
+    for_each_playback_region_(audio_source, [&](const PlaybackRegion&) {
+        has_regions = true;
+        return false;
+    });
+
+    if (!has_regions || !audio_source.prefetch_words(prefetch_pool))
+        return;
+
+    prefetching_sources.insert({audio_source.get_id(), &audio_source});
+    if (!prefetch_timer)
+    {
+        prefetch_timer = Steinberg::owned(Steinberg::Timer::create(
+            Steinberg::newTimerCallback(
+                [this](Steinberg::Timer* /*timer*/) { on_prefetch_timer(); }),
+            PREFETCH_TIMER_INTERVAL_MS));
+    }
+}
+
+//------------------------------------------------------------------------
+void ARADocumentController::on_prefetch_timer()
+{
+    auto iter = prefetching_sources.begin();
+    while (iter != prefetching_sources.end())
+    {
+        const auto* source = iter->second;
+        if (source->is_prefetching())
+        {
+            ++iter;
+            continue;
+        }
+
+        iter = prefetching_sources.erase(iter);
+        on_audio_source_words_changed(*source);
+    }
+
+    if (prefetching_sources.empty())
+        prefetch_timer = nullptr;
+}
+
+//------------------------------------------------------------------------
+void ARADocumentController::on_audio_source_words_changed(
+    const AudioSource& audio_source)
+{
+    // Notify all regions which rely on this audio source
+    const auto func = [&](const PlaybackRegion& region) -> bool {
+        update_timeline_index(region);
+        update_frequency_index(region);
+
+        auto obj = playback_region_observers.find(region.get_id());
+        if (obj != playback_region_observers.end())
+            obj->second();
+
+        return true;
+    };
+
+    update_search_index(audio_source);
+    for_each_playback_region_(audio_source, std::move(func));
 }
 
 //------------------------------------------------------------------------
 void ARADocumentController::on_analyze_audio_source_progress(
     const meta_words::AnalyseProgressData& data)
 {
-    // Notify all regions which rely on this audio source
     if (data.state == meta_words::AnalyseProgressData::State::EndAnalyse)
     {
-        const auto func = [&](const PlaybackRegion& region) -> bool {
-            auto obj = playback_region_observers.find(region.get_id());
-            if (obj != playback_region_observers.end())
-                obj->second();
-
-            return true;
-        };
-
         const auto& sources = getDocument()->getAudioSources<AudioSource>();
         for (const auto& source : sources)
         {
             if (source->get_id() == data.audio_source_id)
             {
-                for_each_playback_region_(*source, std::move(func));
+                on_audio_source_words_changed(*source);
                 break;
             }
         }
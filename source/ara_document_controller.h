@@ -4,13 +4,20 @@
 
 #pragma once
 
+#include "frequency_index.h"
 #include "meta_words_playback_region.h"
+#include "meta_words_serde.h"
+#include "playhead.h"
 #include "region_data.h"
 #include "region_order_manager.h"
+#include "search_index.h"
+#include "thread_pool.h"
+#include "timeline_index.h"
 #include "warn_cpp/suppress_warnings.h"
 #include "tiny_selection_model.h"
 BEGIN_SUPPRESS_WARNINGS
 #include "ARA_Library/PlugIn/ARAPlug.h"
+#include "base/source/timer.h"
 #include "eventpp/callbacklist.h"
 END_SUPPRESS_WARNINGS
 
@@ -100,6 +107,15 @@ public:
         std::unordered_map<Id, RegionPropsChangedCallback>;
     using RegionsById = std::map<Id, PlaybackRegion*>;
 
+    // Words of an audio source as stored last time, kept until they change
+    struct EncodedSource
+    {
+        size_t generation = 0;
+        meta_words::serde::EncodedWordsPtr words;
+    };
+    using EncodedSources = std::unordered_map<Id, EncodedSource>;
+    using AudioSourcesById = std::map<Id, AudioSource*>;
+
     // publish inherited constructor
     using ARA::PlugIn::DocumentController::DocumentController;
     using Super = ARA::PlugIn::DocumentController;
@@ -137,6 +153,9 @@ public:
     void didUpdateAudioSourceProperties(
         ARA::PlugIn::AudioSource* audioSource) noexcept override;
 
+    void doDestroyAudioSource(
+        ARA::PlugIn::AudioSource* audioSource) noexcept override;
+
     ARA::PlugIn::AudioModification* doCreateAudioModification(
         ARA::PlugIn::AudioSource* audioSource,
         ARA::ARAAudioModificationHostRef hostRef,
@@ -212,6 +231,24 @@ public:
         return playback_regions;
     }
 
+    auto get_timeline_index() const -> const TimelineIndex&
+    {
+        return timeline_index;
+    }
+
+    auto get_search_index() const -> const SearchIndex&
+    {
+        return search_index;
+    }
+
+    auto get_frequency_index() const -> const FrequencyIndex&
+    {
+        return frequency_index;
+    }
+
+    auto get_playhead() const -> const Playhead& { return playhead; }
+    auto get_playhead() -> Playhead& { return playhead; }
+
     auto on_region_selected_by_host(Id region_id) -> void;
 
     //--------------------------------------------------------------------
@@ -225,12 +262,26 @@ private:
     RegionChangedCallback region_changed_subject;
 
     RegionsById playback_regions;
+    TimelineIndex timeline_index;
+    SearchIndex search_index;
+    FrequencyIndex frequency_index;
+    EncodedSources encoded_sources;
+    AudioSourcesById prefetching_sources;
+    Steinberg::IPtr<Steinberg::Timer> prefetch_timer;
+    ThreadPool prefetch_pool;
+    Playhead playhead;
 
     std::atomic<bool> _renderersCanAccessModelGraph{true};
     std::atomic<int> _countOfRenderersCurrentlyAccessingModelGraph{0};
 
     void on_add_playback_region(PlaybackRegion* region);
     void on_remove_playback_region(Id id);
+    void update_timeline_index(const PlaybackRegion& region);
+    void update_search_index(const AudioSource& audio_source);
+    void update_frequency_index(const PlaybackRegion& region);
+    void prefetch_words(AudioSource& audio_source);
+    void on_prefetch_timer();
+    void on_audio_source_words_changed(const AudioSource& audio_source);
     void on_analyze_audio_source_progress(
         const meta_words::AnalyseProgressData& data);
 
@@ -0,0 +1,93 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "bk_tree.h"
+#include "string_matcher.h"
+#include <algorithm>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// BkTree
+//------------------------------------------------------------------------
+auto BkTree::add(TermId term_id, const Terms& terms) -> void
+{
+    const auto new_node = static_cast<NodeIndex>(nodes.size());
+    if (nodes.empty())
+    {
+        nodes.push_back({term_id, {}});
+        return;
+    }
+
+    const auto& term  = terms[term_id];
+    NodeIndex current = 0;
+    while (true)
+    {
+        const auto& node_term = terms[nodes[current].term_id];
+        const auto distance   = static_cast<uint32_t>(
+            StringMatcher::editDistance(node_term, term));
+        if (distance == 0)
+            return; // Already in the tree
+
+        auto& children  = nodes[current].children;
+        const auto iter = std::find_if(
+            children.begin(), children.end(),
+            [distance](const Edge& edge) { return edge.distance == distance; });
+
+        if (iter == children.end())
+        {
+            children.push_back({distance, new_node});
+            break;
+        }
+
+        current = iter->node;
+    }
+
+    nodes.push_back({term_id, {}});
+}
+
+//------------------------------------------------------------------------
+auto BkTree::find(StringView query,
+                  Distance max_distance,
+                  const Terms& terms) const -> TermIds
+{
+    TermIds result;
+    if (nodes.empty())
+        return result;
+
+    std::vector<NodeIndex> pending{0};
+    while (!pending.empty())
+    {
+        const auto& node = nodes[pending.back()];
+        pending.pop_back();
+
+        const auto distance =
+            StringMatcher::editDistance(terms[node.term_id], query);
+        if (distance <= max_distance)
+            result.push_back(node.term_id);
+
+        const auto lower =
+            distance > max_distance ? distance - max_distance : 0;
+        const auto upper = distance + max_distance;
+        for (const auto& edge : node.children)
+        {
+            if (edge.distance >= lower && edge.distance <= upper)
+                pending.push_back(edge.node);
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto BkTree::memory_usage() const -> size_t
+{
+    size_t bytes = sizeof(BkTree) + nodes.capacity() * sizeof(Node);
+    for (const auto& node : nodes)
+        bytes += node.children.capacity() * sizeof(Edge);
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,63 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "wordify_types.h"
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// BkTree
+//
+// Burkhard-Keller tree over the vocabulary terms, using the Levenshtein
+// distance. Every child edge is labelled with the distance to its parent,
+// so the triangle inequality limits a query with distance d to the edges
+// within [distance - d, distance + d] of each visited node.
+//
+// The tree only stores term ids, the caller passes the term texts in. They
+// are kept in a deque, so they never move while terms are appended.
+//------------------------------------------------------------------------
+class BkTree
+{
+public:
+    //--------------------------------------------------------------------
+    using TermId     = uint32_t;
+    using TermIds    = std::vector<TermId>;
+    using Terms      = std::deque<StringType>;
+    using Distance   = size_t;
+    using StringView = std::string_view;
+
+    auto add(TermId term_id, const Terms& terms) -> void;
+
+    /** All terms within max_distance of the query, ascending */
+    auto find(StringView query,
+              Distance max_distance,
+              const Terms& terms) const -> TermIds;
+    auto size() const -> size_t { return nodes.size(); }
+    auto memory_usage() const -> size_t;
+
+    //--------------------------------------------------------------------
+private:
+    using NodeIndex = uint32_t;
+
+    struct Edge
+    {
+        uint32_t distance = 0;
+        NodeIndex node    = 0;
+    };
+
+    struct Node
+    {
+        TermId term_id = 0;
+        std::vector<Edge> children;
+    };
+
+    std::vector<Node> nodes;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,106 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "frequency_controller.h"
+#include "ara_document_controller.h"
+#include "search_engine.h"
+#include "warn_cpp/suppress_warnings.h"
+#include <string>
+BEGIN_SUPPRESS_WARNINGS
+#include "vstgui/uidescription/uiattributes.h"
+END_SUPPRESS_WARNINGS
+
+namespace mam {
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// FrequencyController
+//------------------------------------------------------------------------
+FrequencyController::FrequencyController(ARADocumentController* controller)
+: controller(controller)
+{
+}
+
+//------------------------------------------------------------------------
+FrequencyController::~FrequencyController()
+{
+    if (frequency_menu)
+    {
+        frequency_menu->unregisterOptionMenuListener(this);
+        frequency_menu->unregisterViewListener(this);
+        frequency_menu = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------
+CView* FrequencyController::verifyView(CView* view,
+                                       const UIAttributes& attributes,
+                                       const IUIDescription* /*description*/)
+{
+    if (const auto* view_name = attributes.getAttributeValue("uidesc-label"))
+    {
+        if (*view_name == "FrequencyMenu")
+        {
+            frequency_menu = dynamic_cast<COptionMenu*>(view);
+            if (frequency_menu)
+            {
+                frequency_menu->registerOptionMenuListener(this);
+                frequency_menu->registerViewListener(this);
+            }
+        }
+    }
+
+    return view;
+}
+
+//------------------------------------------------------------------------
+void FrequencyController::onOptionMenuPrePopup(COptionMenu* menu)
+{
+    if (!controller)
+        return;
+
+    // Only the top entries are read, the transcript is not touched at all
+    menu->removeAllEntry();
+    const auto& frequency_index = controller->get_frequency_index();
+    const auto snapshot = controller->get_search_index().get_snapshot();
+    const auto& vocabulary = *snapshot.vocabulary;
+
+    // Stop words are the most frequent ones, but say little about the text
+    const auto is_meaningful = [&](const auto& entry) {
+        return !vocabulary.get_stemmer()->is_stop_word(
+            vocabulary.term(entry.term));
+    };
+
+    const auto entries = frequency_index.top_if(MAX_ENTRIES, is_meaningful);
+    for (const auto& entry : entries)
+    {
+        const auto term  = StringType(vocabulary.term(entry.term));
+        const auto title = term + " (" + std::to_string(entry.count) + ")";
+
+        auto item = new CCommandMenuItem({UTF8String(title)});
+        item->setActions([term](auto) {
+            SearchEngine::instance().search(
+                term, SearchEngine::MatchMethod::directMatch);
+        });
+        menu->addEntry(item);
+    }
+
+    if (menu->getNbEntries() == 0)
+        menu->addEntry(UTF8String("No words yet"), -1, CMenuItem::kDisabled);
+    else
+        menu->addEntry(UTF8String("Without stop words like \"the\""), -1,
+                       CMenuItem::kDisabled);
+}
+
+//------------------------------------------------------------------------
+void FrequencyController::viewWillDelete(VSTGUI::CView* view)
+{
+    if (view == frequency_menu)
+    {
+        frequency_menu->unregisterOptionMenuListener(this);
+        frequency_menu->unregisterViewListener(this);
+        frequency_menu = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,62 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "warn_cpp/suppress_warnings.h"
+BEGIN_SUPPRESS_WARNINGS
+#include "base/source/fobject.h"
+#include "vstgui/lib/controls/coptionmenu.h"
+#include "vstgui/lib/iviewlistener.h"
+#include "vstgui/uidescription/icontroller.h"
+END_SUPPRESS_WARNINGS
+
+namespace mam {
+class ARADocumentController;
+
+//------------------------------------------------------------------------
+// FrequencyController
+//
+// Menu of the most frequent words of the project with their counts, read
+// from the FrequencyIndex right before the menu pops up. Stop words like
+// "the" are left out, see Stemmer. Choosing a word searches it and shows
+// it in the search field, so its occurences can be stepped through.
+//------------------------------------------------------------------------
+class FrequencyController : public Steinberg::FObject,
+                            public VSTGUI::IController,
+                            public VSTGUI::ViewListenerAdapter,
+                            public VSTGUI::OptionMenuListenerAdapter
+{
+public:
+    //--------------------------------------------------------------------
+    static constexpr size_t MAX_ENTRIES = 50;
+
+    FrequencyController(ARADocumentController* controller);
+    ~FrequencyController() override;
+
+    // IController
+    void PLUGIN_API update(FUnknown* /*changedUnknown*/,
+                           Steinberg::int32 /*message*/) override {};
+    VSTGUI::CView*
+    verifyView(VSTGUI::CView* view,
+               const VSTGUI::UIAttributes& attributes,
+               const VSTGUI::IUIDescription* description) override;
+
+    // IControlListener
+    void valueChanged(VSTGUI::CControl* /*pControl*/) override {};
+
+    // IViewListener
+    void viewWillDelete(VSTGUI::CView* view) override;
+
+    // IOptionMenuListener
+    void onOptionMenuPrePopup(VSTGUI::COptionMenu* menu) override;
+
+    OBJ_METHODS(FrequencyController, FObject)
+
+    //--------------------------------------------------------------------
+private:
+    ARADocumentController* controller   = nullptr;
+    VSTGUI::COptionMenu* frequency_menu = nullptr;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
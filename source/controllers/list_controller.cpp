@@ -20,8 +20,9 @@ using namespace VSTGUI;
 namespace mam {
 
 //------------------------------------------------------------------------
-constexpr size_t PLAYBACK_REGION_ID_ATTR = 'prid';
-constexpr auto REGION_VIEW_TEMPLATE      = "RegionTemplate";
+constexpr size_t PLAYBACK_REGION_ID_ATTR  = 'prid';
+constexpr auto REGION_VIEW_TEMPLATE       = "RegionTemplate";
+constexpr auto PLAYHEAD_TIMER_INTERVAL_MS = Steinberg::uint32(16); // ~60 fps
 
 //------------------------------------------------------------------------
 static auto find_region_view_by_id(const CRowColumnView& rowColView,
@@ -43,6 +44,24 @@ static auto find_region_view_by_id(const CRowColumnView& rowColView,
     return viewToFind;
 }
 
+//------------------------------------------------------------------------
+static auto find_playhead_word(const TimelineIndex& timeline_index,
+                               TimelineIndex::Seconds time)
+    -> ListController::OptPlayheadWord
+{
+    // Regions can overlap, the word which began last wins.
+    std::optional<TimelineIndex::Entry> found;
+    timeline_index.for_each_at(time, [&](const TimelineIndex::Entry& entry) {
+        if (!found || found->begin < entry.begin)
+            found = entry;
+    });
+
+    if (!found)
+        return std::nullopt;
+
+    return ListController::PlayheadWord{found->region_id, found->word_index};
+}
+
 //------------------------------------------------------------------------
 static auto get_button_state(const SearchEngine::SearchResult& search_results,
                              int32_t control_tag) -> WordButton::State
@@ -50,17 +69,17 @@ static auto get_button_state(const SearchEngine::SearchResult& search_results,
     using State    = WordButton::State;
     auto new_state = State::kNone;
 
-    const auto& indices    = search_results.indices;
     const auto opt_focused = search_results.focused_word;
 
-    auto iter = std::find(indices.begin(), indices.end(), control_tag);
-    if (iter != indices.end())
+    // Every word of a phrase hit is highlighted
+    const auto opt_hit = search_results.find_hit(
+        static_cast<SearchEngine::WordIndex>(control_tag));
+    if (opt_hit)
     {
-        const auto i = std::distance(indices.begin(), iter);
-        new_state    = State::kSearched;
+        new_state = State::kSearched;
         if (opt_focused)
         {
-            new_state = (static_cast<Id>(i) == opt_focused.value())
+            new_state = (opt_hit.value() == opt_focused.value())
                             ? State::kFocused
                             : State::kSearched;
         }
@@ -127,12 +146,13 @@ static auto on_request_select_word(const Id region_id,
     // Get the selected word
     const auto words_data = region->get_region_data();
     const auto& words     = words_data.words;
-    const auto& word      = words.at(word_index);
+    if (!words.contains(word_index))
+        return;
 
     // Compute its time position, BUT limit it to the region start time
     // so the locator will always jump to the beginning of the region
     // no matter if the word start position is already partly outside
-    auto pos = word.word.begin + words_data.project_offset;
+    auto pos = words.begin(word_index) + words_data.project_offset;
     pos      = std::max(pos, region->getStartInPlaybackTime());
     controller->onRequestLocatorPosChanged(pos);
 }
@@ -164,17 +184,32 @@ ListController::ListController(ARADocumentController* document_controller,
                         on_focus_word(result);
                 });
 
+        focus_change_observer_handle =
+            SearchEngine::instance().get_focus_callback().append(
+                [this](const auto& change) { on_focus_change(change); });
+
         region_selected_by_host_handle =
             document_controller->get_region_selected_by_host_subject()->append(
                 [this](const auto& region_id_data) {
                     on_region_selected_by_host(region_id_data.id);
                 });
+
+        playhead_timer = Steinberg::owned(Steinberg::Timer::create(
+            Steinberg::newTimerCallback(
+                [this](Steinberg::Timer* /*timer*/) { on_playhead_timer(); }),
+            PLAYHEAD_TIMER_INTERVAL_MS));
     }
 }
 
 //------------------------------------------------------------------------
 ListController::~ListController()
 {
+    if (playhead_timer)
+    {
+        playhead_timer->stop();
+        playhead_timer = nullptr;
+    }
+
     if (rowColView)
     {
         rowColView->unregisterViewListener(this);
@@ -189,6 +224,9 @@ ListController::~ListController()
         SearchEngine::instance().get_callback().remove(
             focus_word_observer_handle);
 
+        SearchEngine::instance().get_focus_callback().remove(
+            focus_change_observer_handle);
+
         document_controller->get_playback_region_lifetimes_subject()->remove(
             lifetime_observer_handle);
 
@@ -242,6 +280,29 @@ auto ListController::create_list_item_view(const Id id) -> CView*
     return newView;
 }
 
+//------------------------------------------------------------------------
+auto ListController::find_word_button(Id region_id, Index word_index) const
+    -> WordButton*
+{
+    const auto iter = region_controllers.find(region_id);
+    if (iter == region_controllers.end())
+        return nullptr;
+
+    return iter->second->find_word_button(word_index);
+}
+
+//------------------------------------------------------------------------
+template <typename Func>
+auto ListController::for_each_word_button(
+    const SearchEngine::Occurence& occurence, Func&& func) const -> void
+{
+    for (auto i = occurence.first; i < occurence.end; i++)
+    {
+        if (auto* btn = find_word_button(occurence.region_id, i))
+            func(btn);
+    }
+}
+
 //------------------------------------------------------------------------
 void ListController::on_playback_regions_reordered()
 {
@@ -278,6 +339,47 @@ void ListController::on_region_selected_by_host(Id region_id)
     scroll_to_view(rowColView, toFind);
 }
 
+//------------------------------------------------------------------------
+void ListController::on_playhead_timer()
+{
+    if (!rowColView || !document_controller)
+        return;
+
+    // Nothing to do as long as the playhead does not move
+    const auto playhead = document_controller->get_playhead().read();
+    if (playhead.time == playhead_time)
+        return;
+
+    playhead_time = playhead.time;
+
+    const auto new_word = find_playhead_word(
+        document_controller->get_timeline_index(), playhead.time);
+    if (new_word == playhead_word)
+        return;
+
+    // Only touch the buttons whose state actually changes
+    if (playhead_word)
+    {
+        const auto [region_id, word_index] = playhead_word.value();
+        auto* btn = find_word_button(region_id, word_index);
+        if (btn && btn->setPlayhead(false))
+            btn->invalid();
+    }
+
+    playhead_word = new_word;
+    if (playhead_word)
+    {
+        const auto [region_id, word_index] = playhead_word.value();
+        auto* btn = find_word_button(region_id, word_index);
+        if (btn && btn->setPlayhead(true))
+        {
+            btn->invalid();
+            if (playhead.is_playing)
+                scroll_to_view(rowColView, btn);
+        }
+    }
+}
+
 //------------------------------------------------------------------------
 void ListController::on_add_remove_playback_region(
     const RegionLifetimeEventData& data)
@@ -302,6 +404,7 @@ void ListController::on_add_remove_playback_region(
             break;
         }
         case RegionLifetimeEventData::Event::WillBeRemoved: {
+            region_controllers.erase(data.id);
             auto* viewToRemove = find_region_view_by_id(*rowColView, data.id);
             if (viewToRemove)
             {
@@ -348,7 +451,11 @@ ListController::createSubController(UTF8StringPtr name,
             on_request_select_word(pbr_id, index, document_controller);
         };
 
-        return subctrl->initialize(&subject) ? subctrl : nullptr;
+        if (!subctrl->initialize(&subject))
+            return nullptr;
+
+        region_controllers[pbr_id] = subctrl;
+        return subctrl;
     }
 
     return nullptr;
@@ -398,6 +505,43 @@ void ListController::on_focus_word(
     }
 }
 
+//------------------------------------------------------------------------
+void ListController::on_focus_change(const SearchEngine::FocusChange& change)
+{
+    if (change.current)
+    {
+        const auto& current = change.current.value();
+        on_request_select_word(current.region_id, current.first,
+                               document_controller);
+        document_controller->get_region_selection_model().select(
+            {current.region_id, current.first});
+    }
+
+    // ui update, only the buttons of both occurences change
+    if (!rowColView)
+        return;
+
+    if (change.previous)
+    {
+        for_each_word_button(change.previous.value(), [](WordButton* btn) {
+            if (btn->setState(WordButton::State::kSearched))
+                btn->invalid();
+        });
+    }
+
+    if (change.current)
+    {
+        const auto& current = change.current.value();
+        for_each_word_button(current, [&](WordButton* btn) {
+            if (btn->getTag() == static_cast<int32_t>(current.first))
+                scroll_to_view(rowColView, btn);
+
+            if (btn->setState(WordButton::State::kFocused))
+                btn->invalid();
+        });
+    }
+}
+
 //------------------------------------------------------------------------
 void ListController::viewWillDelete(VSTGUI::CView* view)
 {
@@ -405,6 +549,7 @@ void ListController::viewWillDelete(VSTGUI::CView* view)
     {
         rowColView->unregisterViewListener(this);
         rowColView = nullptr;
+        region_controllers.clear();
     }
 }
 
@@ -5,9 +5,11 @@
 #include "search_engine.h"
 #include "warn_cpp/suppress_warnings.h"
 #include "wordify_types.h"
+#include <unordered_map>
 BEGIN_SUPPRESS_WARNINGS
 #include "ara_document_controller.h"
 #include "base/source/fobject.h"
+#include "base/source/timer.h"
 #include "vstgui/lib/iviewlistener.h"
 #include "vstgui/uidescription/icontroller.h"
 END_SUPPRESS_WARNINGS
@@ -21,6 +23,9 @@ namespace mam {
 namespace meta_words {
 class PlaybackRegion;
 }
+class RegionController;
+class WordButton;
+
 //------------------------------------------------------------------------
 // ListController
 //------------------------------------------------------------------------
@@ -39,6 +44,8 @@ public:
     using UTF8StringPtr       = VSTGUI::UTF8StringPtr;
     using IController         = VSTGUI::IController;
     using OptPlaybackRegionId = std::optional<Id>;
+    using PlayheadWord        = std::pair<Id, Index>; // region id, word index
+    using OptPlayheadWord     = std::optional<PlayheadWord>;
 
     ListController(ARADocumentController* document_controller,
                    const IUIDescription* uidesc);
@@ -65,20 +72,37 @@ public:
     //--------------------------------------------------------------------
 private:
     void on_focus_word(const SearchEngine::SearchResult& search_result);
+    void on_focus_change(const SearchEngine::FocusChange& change);
     void on_add_remove_playback_region(const RegionLifetimeEventData& data);
     void on_playback_regions_reordered();
     void on_region_selected_by_host(Id region_id);
+    void on_playhead_timer();
     auto create_list_item_view(const Id id) -> VSTGUI::CView*;
+    auto find_word_button(Id region_id, Index word_index) const
+        -> WordButton*;
+    template <typename Func>
+    auto for_each_word_button(const SearchEngine::Occurence& occurence,
+                              Func&& func) const -> void;
+
+    // The region controllers belong to their region views and live as
+    // long as those, so do the entries here
+    using RegionControllers = std::unordered_map<Id, RegionController*>;
 
     RowColumnView* rowColView                  = nullptr;
     ARADocumentController* document_controller = nullptr;
     const IUIDescription* uidesc               = nullptr;
     OptPlaybackRegionId playback_region_id;
+    RegionControllers region_controllers;
+
+    Steinberg::IPtr<Steinberg::Timer> playhead_timer;
+    Playhead::Seconds playhead_time = -1.;
+    OptPlayheadWord playhead_word;
 
     RegionLifetimeCallback::Handle lifetime_observer_handle;
     RegionsOrderCallback::Handle order_observer_handle;
     RegionSelectedByHostCallback::Handle region_selected_by_host_handle;
     SearchEngine::SearchEngineCallback::Handle focus_word_observer_handle;
+    SearchEngine::FocusCallback::Handle focus_change_observer_handle;
 };
 
 //------------------------------------------------------------------------
@@ -0,0 +1,171 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "live_transcript_controller.h"
+#include "warn_cpp/suppress_warnings.h"
+BEGIN_SUPPRESS_WARNINGS
+#include "vstgui/lib/controls/ctextlabel.h"
+#include "vstgui/lib/crowcolumnview.h"
+#include "vstgui/lib/cscrollview.h"
+#include "vstgui/uidescription/iuidescription.h"
+END_SUPPRESS_WARNINGS
+
+using namespace VSTGUI;
+
+namespace mam {
+namespace {
+
+//------------------------------------------------------------------------
+constexpr auto POLL_TIMER_INTERVAL_MS = Steinberg::uint32(100);
+constexpr auto TRANSCRIPT_FONT        = "region_transcript_font";
+constexpr auto TRANSCRIPT_TEXT_COLOR  = "transcript_text_color";
+
+//------------------------------------------------------------------------
+auto create_transcript_label(const CRowColumnView& rowColView,
+                             const IUIDescription* uidesc)
+    -> CMultiLineTextLabel*
+{
+    const auto margin = rowColView.getMargin();
+    const auto width  = rowColView.getWidth() - margin.left - margin.right;
+
+    auto* label = new CMultiLineTextLabel(CRect(0., 0., width, 0.));
+    label->setLineLayout(CMultiLineTextLabel::LineLayout::wrap);
+    label->setAutoHeight(true);
+    label->setHoriAlign(kLeftText);
+    label->setStyle(CParamDisplay::kNoFrame);
+    label->setTransparency(true);
+    label->setMouseEnabled(false);
+
+    if (uidesc)
+    {
+        if (auto* font = uidesc->getFont(TRANSCRIPT_FONT))
+            label->setFont(font);
+
+        CColor color;
+        if (uidesc->getColor(TRANSCRIPT_TEXT_COLOR, color))
+            label->setFontColor(color);
+    }
+
+    return label;
+}
+
+//------------------------------------------------------------------------
+auto scroll_to_bottom(CRowColumnView* rowColView, const CView* view)
+{
+    auto parent = rowColView->getParentView();
+    if (!parent)
+        return;
+
+    parent = parent->getParentView();
+    if (!parent)
+        return;
+
+    if (auto scroll_view = dynamic_cast<CScrollView*>(parent))
+    {
+        CRect r = view->getViewSize();
+        r.top   = r.bottom - 1.;
+
+        CPoint p;
+        view->localToFrame(p);
+        scroll_view->frameToLocal(p);
+        r.offset(p.x, p.y);
+        scroll_view->makeRectVisible(r);
+    }
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// LiveTranscriptController
+//------------------------------------------------------------------------
+LiveTranscriptController::LiveTranscriptController(
+    LiveTranscriber* live_transcriber, const IUIDescription* uidesc)
+: live_transcriber(live_transcriber)
+, uidesc(uidesc)
+{
+    if (live_transcriber)
+    {
+        poll_timer = Steinberg::owned(Steinberg::Timer::create(
+            Steinberg::newTimerCallback(
+                [this](Steinberg::Timer* /*timer*/) { on_poll_timer(); }),
+            POLL_TIMER_INTERVAL_MS));
+    }
+}
+
+//------------------------------------------------------------------------
+LiveTranscriptController::~LiveTranscriptController()
+{
+    if (poll_timer)
+    {
+        poll_timer->stop();
+        poll_timer = nullptr;
+    }
+
+    if (rowColView)
+    {
+        rowColView->unregisterViewListener(this);
+        rowColView = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------
+CView* LiveTranscriptController::verifyView(
+    CView* view,
+    const UIAttributes& /*attributes*/,
+    const IUIDescription* /*description*/)
+{
+    if (!rowColView)
+    {
+        rowColView = dynamic_cast<CRowColumnView*>(view);
+        if (rowColView)
+        {
+            rowColView->registerViewListener(this);
+
+            transcript_label = create_transcript_label(*rowColView, uidesc);
+            rowColView->addView(transcript_label);
+            rowColView->sizeToFit();
+        }
+    }
+
+    return view;
+}
+
+//------------------------------------------------------------------------
+void LiveTranscriptController::on_poll_timer()
+{
+    if (!live_transcriber || !rowColView || !transcript_label)
+        return;
+
+    new_words.clear();
+    const auto count = live_transcriber->copy_words(count_words, new_words);
+    if (count == 0)
+        return;
+
+    count_words += count;
+    for (const auto& word : new_words)
+    {
+        if (!transcript.empty())
+            transcript += " ";
+
+        transcript += word.value;
+    }
+
+    transcript_label->setText(UTF8String(transcript));
+    rowColView->sizeToFit();
+    rowColView->invalid();
+    scroll_to_bottom(rowColView, transcript_label);
+}
+
+//------------------------------------------------------------------------
+void LiveTranscriptController::viewWillDelete(CView* view)
+{
+    if (view == rowColView)
+    {
+        rowColView->unregisterViewListener(this);
+        rowColView       = nullptr;
+        transcript_label = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
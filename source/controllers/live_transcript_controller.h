@@ -0,0 +1,77 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "live_transcriber.h"
+#include "warn_cpp/suppress_warnings.h"
+#include "wordify_types.h"
+BEGIN_SUPPRESS_WARNINGS
+#include "base/source/fobject.h"
+#include "base/source/timer.h"
+#include "vstgui/lib/iviewlistener.h"
+#include "vstgui/uidescription/icontroller.h"
+END_SUPPRESS_WARNINGS
+
+namespace VSTGUI {
+class CMultiLineTextLabel;
+class CRowColumnView;
+class IUIDescription;
+} // namespace VSTGUI
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// LiveTranscriptController
+//
+// Shows the words of the LiveTranscriber in the transcript list when the
+// plug-in runs without ARA. Polls for new words on a timer and appends them
+// to a single multi line label. When the editor is opened again, the
+// transcript is rebuilt from all words transcribed so far.
+//------------------------------------------------------------------------
+class LiveTranscriptController : public Steinberg::FObject,
+                                 public VSTGUI::IController,
+                                 public VSTGUI::ViewListenerAdapter
+{
+public:
+    //--------------------------------------------------------------------
+    using View           = VSTGUI::CView;
+    using RowColumnView  = VSTGUI::CRowColumnView;
+    using TextLabel      = VSTGUI::CMultiLineTextLabel;
+    using UIAttributes   = VSTGUI::UIAttributes;
+    using IUIDescription = VSTGUI::IUIDescription;
+
+    LiveTranscriptController(LiveTranscriber* live_transcriber,
+                             const IUIDescription* uidesc);
+    ~LiveTranscriptController() override;
+
+    void PLUGIN_API update(FUnknown* /*changedUnknown*/,
+                           Steinberg::int32 /*message*/) override {};
+    View* verifyView(View* view,
+                     const UIAttributes& attributes,
+                     const IUIDescription* description) override;
+
+    // IControlListener
+    void valueChanged(VSTGUI::CControl* /*pControl*/) override {};
+
+    // ViewListenerAdapter
+    void viewWillDelete(View* view) override;
+
+    OBJ_METHODS(LiveTranscriptController, FObject)
+
+    //--------------------------------------------------------------------
+private:
+    void on_poll_timer();
+
+    LiveTranscriber* live_transcriber = nullptr;
+    const IUIDescription* uidesc      = nullptr;
+    RowColumnView* rowColView         = nullptr;
+    TextLabel* transcript_label       = nullptr;
+    StringType transcript;
+    size_t count_words = 0;
+    LiveTranscriber::MetaWords new_words;
+
+    Steinberg::IPtr<Steinberg::Timer> poll_timer;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -127,21 +127,18 @@ CView* PreferencesController::verifyView(CView* view,
                 auto export_submenu = new COptionMenu();
                 options_menu->addEntry(export_submenu, "Export");
 
-                item = new CCommandMenuItem({"JSON..."});
-                item->setActions([this](auto) {
-                    export_file(collect_playback_regions(*controller),
-                                *(options_menu->getFrame()),
-                                exporter::Format::JSON, last_file_path);
-                });
-                export_submenu->addEntry(item);
-
-                item = new CCommandMenuItem({"SubRip..."});
-                item->setActions([this](auto) {
-                    export_file(collect_playback_regions(*controller),
-                                *(options_menu->getFrame()),
-                                exporter::Format::SRT, last_file_path);
-                });
-                export_submenu->addEntry(item);
+                for (const auto& entry : exporter::get_format_registry())
+                {
+                    const auto format = entry.format;
+                    item              = new CCommandMenuItem(
+                        {UTF8String(entry.info.description + "...")});
+                    item->setActions([this, format](auto) {
+                        export_file(collect_playback_regions(*controller),
+                                    *(options_menu->getFrame()), format,
+                                    last_file_path);
+                    });
+                    export_submenu->addEntry(item);
+                }
 
                 options_menu->addEntry(UTF8String("v") + VERSION_STR, -1,
                                        CMenuItem::kDisabled);
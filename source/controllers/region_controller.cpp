@@ -62,19 +62,19 @@ static auto update_region_duration_time(CTextLabel& region_duration_time,
 }
 
 //------------------------------------------------------------------------
-using WordWidths = std::vector<CCoord>;
+using Word = StringType;
 template <typename Func>
-static auto compute_word_widths(const RegionData& region_data,
-                                const Func& width_func) -> WordWidths
+static auto update_word_widths(const RegionData& region_data,
+                               RegionController::Cache::Widths& widths,
+                               const Func& width_func) -> void
 {
-    WordWidths widths;
-    for (const auto& meta_word_data : region_data.words)
+    const auto& words = region_data.words;
+    for (auto i = words.first(); i < words.last(); i++)
     {
-        const auto width = width_func(meta_word_data.word.value);
-        widths.push_back(width);
+        const auto term = words.term(i);
+        if (widths.find(term) == widths.end())
+            widths.emplace(term, width_func(Word(words.text(i))));
     }
-
-    return widths;
 }
 
 //------------------------------------------------------------------------
@@ -94,23 +94,6 @@ static auto find_view_after(CViewContainer* container, size_t tag) -> CView*
 }
 
 //------------------------------------------------------------------------
-static auto find_view_with_tag(CViewContainer* container, size_t tag) -> CView*
-{
-    for (uint32_t i = 0; i < container->getNbViews(); i++)
-    {
-        auto* view = container->getView(i);
-        if (auto control = dynamic_cast<CControl*>(view))
-        {
-            if (control->getTag() == static_cast<int32_t>(tag))
-                return control;
-        }
-    }
-
-    return nullptr;
-}
-
-//------------------------------------------------------------------------
-using Word = StringType;
 static auto compute_word_width(const IUIDescription* description,
                                Word word) -> CCoord
 {
@@ -123,7 +106,8 @@ static auto compute_word_width(const IUIDescription* description,
 
 //------------------------------------------------------------------------
 static auto remove_word_buttons(CViewContainer& region_transcript,
-                                const RegionData& region_data)
+                                const RegionData& region_data,
+                                RegionController::WordButtons& word_buttons)
 {
     using Controls = std::vector<CControl*>;
 
@@ -132,13 +116,9 @@ static auto remove_word_buttons(CViewContainer& region_transcript,
     region_transcript.forEachChild([&](CView* child) {
         if (auto* control = dynamic_cast<CControl*>(child))
         {
-            const auto word_index = control->getTag();
-            bool to_be_removed    = true;
-            if (size_t(word_index) < region_data.words.size())
-            {
-                to_be_removed =
-                    region_data.words[word_index].is_clipped_by_region;
-            }
+            const auto word_index = static_cast<Index>(control->getTag());
+            const bool to_be_removed =
+                region_data.words.is_clipped_by_region(word_index);
 
             if (to_be_removed)
                 buttons_to_remove.push_back(control);
@@ -146,39 +126,43 @@ static auto remove_word_buttons(CViewContainer& region_transcript,
     });
 
     for (auto* child : buttons_to_remove)
+    {
+        word_buttons.erase(static_cast<Index>(child->getTag()));
         region_transcript.removeView(child);
+    }
 }
 
 //------------------------------------------------------------------------
-using OptTextButton = std::optional<CTextButton*>;
+using OptWordButton = std::optional<WordButton*>;
 template <typename Func>
 void insert_word_buttons(const mam::RegionController::Cache& cache,
                          const mam::RegionData& region_data,
                          CViewContainer* region_transcript,
+                         RegionController::WordButtons& word_buttons,
                          Func&& but_create_func)
 {
     const auto& word_widths = cache.word_widths;
-    for (size_t word_index = 0; word_index < region_data.words.size();
+    const auto& words       = region_data.words;
+    for (auto word_index = words.first(); word_index < words.last();
          ++word_index)
     {
         // Don't add a button for words which are clipped
-        const auto word_data = region_data.words[word_index];
-        if (word_data.is_clipped_by_region)
+        if (words.is_clipped_by_region(word_index))
             continue;
 
         // Continue if button already exists
-        if (find_view_with_tag(region_transcript, word_index))
+        if (word_buttons.count(word_index) > 0)
             continue;
 
         // Setting gradients to nullptr improves performance quite a lot when
         // redrawing
         const auto but_gradient = nullptr;
-        const auto but_title    = UTF8String(word_data.word.value);
-        const auto but_width    = word_widths[word_index];
-        const auto but_enabled  = !word_data.is_punctuation_mark;
+        const auto but_title    = UTF8String(Word(words.text(word_index)));
+        const auto but_width    = word_widths.at(words.term(word_index));
+        const auto but_enabled  = !words.is_punctuation_mark(word_index);
         const auto but_tag      = int32_t(word_index);
 
-        OptTextButton opt_button = but_create_func();
+        OptWordButton opt_button = but_create_func();
         if (!opt_button.has_value())
             continue;
 
@@ -205,6 +189,7 @@ void insert_word_buttons(const mam::RegionController::Cache& cache,
         // Insert the button at position
         auto* view_after = find_view_after(region_transcript, but_tag);
         region_transcript->addView(button, view_after);
+        word_buttons[word_index] = button;
     }
 }
 
@@ -370,12 +355,13 @@ update_region_transcript(CViewContainer* region_transcript,
                          const IUIDescription* description,
                          const UIAttributes& attributes,
                          IControlListener* listener,
-                         const RegionController::Cache& cache) -> void
+                         const RegionController::Cache& cache,
+                         RegionController::WordButtons& word_buttons) -> void
 {
     if (!region_transcript)
         return;
 
-    auto but_creator = [&]() -> OptTextButton {
+    auto but_creator = [&]() -> OptWordButton {
         const auto but_factory = description->getViewFactory();
         if (!but_factory)
             return std::nullopt;
@@ -398,8 +384,9 @@ update_region_transcript(CViewContainer* region_transcript,
         return std::nullopt;
     };
 
-    remove_word_buttons(*region_transcript, region_data);
-    insert_word_buttons(cache, region_data, region_transcript, but_creator);
+    remove_word_buttons(*region_transcript, region_data, word_buttons);
+    insert_word_buttons(cache, region_data, region_transcript, word_buttons,
+                        but_creator);
 }
 
 //------------------------------------------------------------------------
@@ -504,6 +491,13 @@ bool RegionController::initialize(Subject* subject_)
     return true;
 }
 
+//------------------------------------------------------------------------
+auto RegionController::find_word_button(Index word_index) const -> WordButton*
+{
+    const auto iter = word_buttons.find(word_index);
+    return iter != word_buttons.end() ? iter->second : nullptr;
+}
+
 //------------------------------------------------------------------------
 void RegionController::on_region_changed()
 {
@@ -522,11 +516,12 @@ void RegionController::on_region_changed()
     {
         init_words_width_cache(region_data);
 
-        if (!region_data.words.empty())
+        if (region_data.words.is_valid())
             remove_loading_indicator(region_transcript);
 
         update_region_transcript(region_transcript, region_data, description,
-                                 meta_word_button_attributes, this, cache);
+                                 meta_word_button_attributes, this, cache,
+                                 word_buttons);
         region_transcript->invalid();
     }
 }
@@ -534,12 +529,18 @@ void RegionController::on_region_changed()
 //------------------------------------------------------------------------
 void RegionController::init_words_width_cache(const RegionData& data)
 {
-    if (cache.word_widths.empty())
+    // Term ids refer to the word store, so a new one invalidates them
+    if (cache.word_store != data.words.get_store())
     {
-        cache.word_widths = compute_word_widths(data, [&](const Word& word) {
-            return compute_word_width(description, word);
-        });
+        cache.word_widths.clear();
+        cache.word_store = data.words.get_store();
     }
+
+    // Only words which became visible in the region's window need to be
+    // measured
+    update_word_widths(data, cache.word_widths, [&](const Word& word) {
+        return compute_word_width(description, word);
+    });
 }
 
 //------------------------------------------------------------------------
@@ -580,7 +581,7 @@ CView* RegionController::verifyView(CView* view,
             stack_layout = std::make_unique<HStackLayout>(region_transcript);
             stack_layout->setup({0., 0.}, {0., 0., 0., 0.});
 
-            if (data.words.empty())
+            if (!data.words.is_valid())
                 add_loading_indicator(region_transcript, description);
         }
         else if (*viewLabel == "MetaWordButton")
@@ -619,8 +620,10 @@ void RegionController::viewAttached(CView* view)
     }
     else if (view == region_transcript)
     {
+        init_words_width_cache(data);
         update_region_transcript(region_transcript, data, description,
-                                 meta_word_button_attributes, this, cache);
+                                 meta_word_button_attributes, this, cache,
+                                 word_buttons);
     }
 }
 
@@ -649,6 +652,7 @@ void RegionController::viewWillDelete(CView* view)
     {
         region_transcript->unregisterViewListener(this);
         region_transcript = nullptr;
+        word_buttons.clear();
     }
 }
 
@@ -4,6 +4,7 @@
 
 #include "region_data.h"
 #include "warn_cpp/suppress_warnings.h"
+#include <unordered_map>
 BEGIN_SUPPRESS_WARNINGS
 #include "base/source/fobject.h"
 #include "eventpp/callbacklist.h"
@@ -23,6 +24,7 @@ class CView;
 namespace mam {
 
 class HStackLayout;
+class WordButton;
 
 //------------------------------------------------------------------------
 // RegionController
@@ -38,11 +40,15 @@ public:
     using Subject            = eventpp::CallbackList<void(void)>;
     using ObserverHandle     = Subject::Handle;
     using Width              = VSTGUI::CCoord;
+    using WordButtons        = std::unordered_map<Index, WordButton*>;
 
     struct Cache
     {
-        using Widths = std::vector<Width>;
+        // Word widths by interned term, only for words which have been
+        // visible. Repeated words are measured once.
+        using Widths = std::unordered_map<RegionWords::TermId, Width>;
         Widths word_widths;
+        meta_words::WordStorePtr word_store;
     };
 
     RegionController(const VSTGUI::IUIDescription* description);
@@ -50,6 +56,9 @@ public:
 
     bool initialize(Subject* subject);
 
+    /** Button of the word, none while it is not shown */
+    auto find_word_button(Index word_index) const -> WordButton*;
+
     VSTGUI::CView*
     verifyView(VSTGUI::CView* view,
                const VSTGUI::UIAttributes& attributes,
@@ -84,6 +93,7 @@ private:
     Subject* subject = nullptr;
     ObserverHandle observer_handle;
     Cache cache;
+    WordButtons word_buttons; // By word index, see find_word_button
 };
 //------------------------------------------------------------------------
 } // namespace mam
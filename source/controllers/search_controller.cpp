@@ -2,6 +2,7 @@
 
 #include "search_controller.h"
 #include "ara_document_controller.h"
+#include "preferences_serde.h"
 #include "search_engine.h"
 #include "string_matcher.h"
 #include "warn_cpp/suppress_warnings.h"
@@ -23,12 +24,33 @@ enum
     kSearchFieldTag = 1000,
 };
 
+constexpr auto DISPATCH_TIMER_INTERVAL_MS = Steinberg::uint32(16);
+
 //------------------------------------------------------------------------
-auto string_match_method(Steinberg::Vst::Parameter* smart_search_param)
+auto string_match_method(Steinberg::Vst::Parameter* smart_search_param,
+                         Steinberg::Vst::Parameter* smart_search_method_param)
 {
     bool mode = smart_search_param->getNormalized() > 0.;
-    return mode ? StringMatcher::MatchMethod::nearbyFuzzyMatch
-                : StringMatcher::MatchMethod::directMatch;
+    if (!mode)
+        return StringMatcher::MatchMethod::directMatch;
+
+    if (!smart_search_method_param)
+        return StringMatcher::MatchMethod::nearbyFuzzyMatch;
+
+    using SmartSearchMethod = meta_words::serde::SmartSearchMethod;
+
+    const auto method =
+        static_cast<SmartSearchMethod>(smart_search_method_param->toPlain(
+            smart_search_method_param->getNormalized()));
+    switch (method)
+    {
+        case SmartSearchMethod::SoundsLike:
+            return StringMatcher::MatchMethod::phoneticMatch;
+        case SmartSearchMethod::Stemmed:
+            return StringMatcher::MatchMethod::stemMatch;
+        case SmartSearchMethod::Fuzzy:
+        default: return StringMatcher::MatchMethod::nearbyFuzzyMatch;
+    }
 }
 
 //------------------------------------------------------------------------
@@ -36,9 +58,11 @@ auto string_match_method(Steinberg::Vst::Parameter* smart_search_param)
 //------------------------------------------------------------------------
 SearchController::SearchController(
     ARADocumentController* controller,
-    Steinberg::Vst::Parameter* smart_search_param)
+    Steinberg::Vst::Parameter* smart_search_param,
+    Steinberg::Vst::Parameter* smart_search_method_param)
 : controller(controller)
 , smart_search_param(smart_search_param)
+, smart_search_method_param(smart_search_method_param)
 {
     if (!controller)
         return;
@@ -47,9 +71,23 @@ SearchController::SearchController(
         return controller->get_playback_regions();
     };
 
+    SearchEngine::instance().get_search_index = [controller]() {
+        return controller->get_search_index().get_snapshot();
+    };
+
+    SearchEngine::instance().start_worker();
+    dispatch_timer = Steinberg::owned(Steinberg::Timer::create(
+        Steinberg::newTimerCallback([](Steinberg::Timer* /*timer*/) {
+            SearchEngine::instance().dispatch_results();
+        }),
+        DISPATCH_TIMER_INTERVAL_MS));
+
     if (smart_search_param)
         smart_search_param->addDependent(this);
 
+    if (smart_search_method_param)
+        smart_search_method_param->addDependent(this);
+
     region_props_changed_observer_handle =
         controller->get_region_changed_subject().append(
             [&](const auto&) { clear_search(); });
@@ -57,11 +95,23 @@ SearchController::SearchController(
     region_lifetime_observer_handle =
         controller->get_playback_region_lifetimes_subject()->append(
             [&](const auto&) { clear_search(); });
+
+    // Searches started elsewhere, e.g. from the FrequencyController
+    search_word_observer_handle =
+        SearchEngine::instance().get_search_word_callback().append(
+            [&](const auto& search_word) { on_search_word(search_word); });
 }
 
 //------------------------------------------------------------------------
 SearchController::~SearchController()
 {
+    if (dispatch_timer)
+    {
+        dispatch_timer->stop();
+        dispatch_timer = nullptr;
+        SearchEngine::instance().stop_worker();
+    }
+
     if (search_field)
     {
         search_field->unregisterViewListener(this);
@@ -75,13 +125,22 @@ SearchController::~SearchController()
 
         controller->get_playback_region_lifetimes_subject()->remove(
             region_lifetime_observer_handle);
+
+        SearchEngine::instance().get_search_word_callback().remove(
+            search_word_observer_handle);
     }
 
     if (smart_search_param)
         smart_search_param->removeDependent(this);
 
+    if (smart_search_method_param)
+        smart_search_method_param->removeDependent(this);
+
     if (SearchEngine::instance().get_regions)
         SearchEngine::instance().get_regions = nullptr;
+
+    if (SearchEngine::instance().get_search_index)
+        SearchEngine::instance().get_search_index = nullptr;
 }
 
 //------------------------------------------------------------------------
@@ -90,13 +149,10 @@ void PLUGIN_API SearchController::update(FUnknown* changedUnknown,
 {
     if (auto* param = FCast<Vst::Parameter>(changedUnknown))
     {
-        if (param == smart_search_param)
+        if (param == smart_search_param || param == smart_search_method_param)
         {
-            const auto smm = string_match_method(smart_search_param);
-            SearchEngine::instance().research(
-                [&](const auto& s0, const auto& s1) -> bool {
-                    return StringMatcher::isMatch(s0, s1, smm);
-                });
+            SearchEngine::instance().research(string_match_method(
+                smart_search_param, smart_search_method_param));
         }
     }
 }
@@ -152,12 +208,10 @@ void SearchController::valueChanged(CControl* control)
                     SearchEngine::instance().clear_results();
                 else
                 {
-                    const auto smm = string_match_method(smart_search_param);
                     SearchEngine::instance().search(
                         search_word,
-                        [&](const auto& s0, const auto& s1) -> bool {
-                            return StringMatcher::isMatch(s0, s1, smm);
-                        });
+                        string_match_method(smart_search_param,
+                                            smart_search_method_param));
                 }
             }
 
@@ -185,5 +239,12 @@ void SearchController::clear_search()
     SearchEngine::instance().clear_results();
 }
 
+//------------------------------------------------------------------------
+void SearchController::on_search_word(const StringType& search_word)
+{
+    if (search_field && search_field->getText().getString() != search_word)
+        search_field->setText(UTF8String(search_word));
+}
+
 //------------------------------------------------------------------------
 } // namespace mam
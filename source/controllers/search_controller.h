@@ -3,9 +3,11 @@
 #pragma once
 
 #include "ara_document_controller.h"
+#include "search_engine.h"
 #include "warn_cpp/suppress_warnings.h"
 BEGIN_SUPPRESS_WARNINGS
 #include "base/source/fobject.h"
+#include "base/source/timer.h"
 #include "vstgui/lib/iviewlistener.h"
 #include "vstgui/uidescription/icontroller.h"
 END_SUPPRESS_WARNINGS
@@ -30,7 +32,8 @@ class SearchController : public Steinberg::FObject,
 public:
     //--------------------------------------------------------------------
     SearchController(ARADocumentController* controller,
-                     Steinberg::Vst::Parameter* smart_search_param);
+                     Steinberg::Vst::Parameter* smart_search_param,
+                     Steinberg::Vst::Parameter* smart_search_method_param);
     ~SearchController() override;
 
     void PLUGIN_API update(FUnknown* changedUnknown,
@@ -59,13 +62,19 @@ public:
     //--------------------------------------------------------------------
 private:
     ARADocumentController* controller             = nullptr;
-    Steinberg::Vst::Parameter* smart_search_param = nullptr;
-    VSTGUI::CSearchTextEdit* search_field         = nullptr;
+    Steinberg::Vst::Parameter* smart_search_param        = nullptr;
+    Steinberg::Vst::Parameter* smart_search_method_param = nullptr;
+    VSTGUI::CSearchTextEdit* search_field                = nullptr;
 
     RegionChangedCallback::Handle region_props_changed_observer_handle;
     RegionLifetimeCallback::Handle region_lifetime_observer_handle;
+    SearchEngine::SearchWordCallback::Handle search_word_observer_handle;
+
+    // Delivers the results of the background search on the UI thread
+    Steinberg::IPtr<Steinberg::Timer> dispatch_timer;
 
     void clear_search();
+    void on_search_word(const StringType& search_word);
 };
 
 //------------------------------------------------------------------------
@@ -0,0 +1,727 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "double_metaphone.h"
+#include <algorithm>
+#include <initializer_list>
+
+namespace mam::double_metaphone {
+namespace {
+
+//------------------------------------------------------------------------
+// Latin-1 letters U+00E0 to U+00FF, ' ' drops the code point
+constexpr StringView LATIN_1_LETTERS = "AAAAAAASEEEEIIIIDNOOOOO OUUUUY Y";
+
+//------------------------------------------------------------------------
+auto transliterate(StringView word) -> StringType
+{
+    StringType result;
+    result.reserve(word.size());
+    for (size_t pos = 0; pos < word.size(); pos++)
+    {
+        const auto c = static_cast<unsigned char>(word[pos]);
+        if (c >= 'a' && c <= 'z')
+        {
+            result.push_back(static_cast<char>(c - 'a' + 'A'));
+        }
+        else if (c >= 'A' && c <= 'Z')
+        {
+            result.push_back(static_cast<char>(c));
+        }
+        else if (c == 0xC3 && pos + 1 < word.size())
+        {
+            // Two byte UTF-8 sequence of U+00C0 to U+00FF
+            const auto code_point =
+                0xC0 | (static_cast<unsigned char>(word[++pos]) & 0x3F);
+            auto letter = ' ';
+            if (code_point == 0xDF)
+                result += "SS";
+            else if (code_point >= 0xE0)
+                letter = LATIN_1_LETTERS[code_point - 0xE0];
+
+            if (letter != ' ')
+                result.push_back(letter);
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+class Encoder
+{
+public:
+    //--------------------------------------------------------------------
+    using Options = std::initializer_list<StringView>;
+
+    explicit Encoder(StringType&& word)
+    : word(std::move(word))
+    {
+    }
+
+    auto encode() -> Keys;
+
+    //--------------------------------------------------------------------
+private:
+    auto at(int pos) const -> char
+    {
+        return pos >= 0 && pos < length() ? word[pos] : '\0';
+    }
+
+    auto length() const -> int { return static_cast<int>(word.size()); }
+
+    /** The substring at pos equals one of the options */
+    auto is_at(int pos, int count, Options options) const -> bool
+    {
+        if (pos < 0 || pos + count > length())
+            return false;
+
+        const auto sub = StringView(word).substr(pos, count);
+        for (const auto option : options)
+        {
+            if (sub == option)
+                return true;
+        }
+
+        return false;
+    }
+
+    auto is_vowel(int pos) const -> bool
+    {
+        switch (at(pos))
+        {
+            case 'A':
+            case 'E':
+            case 'I':
+            case 'O':
+            case 'U':
+            case 'Y': return true;
+            default: return false;
+        }
+    }
+
+    auto is_slavo_germanic() const -> bool
+    {
+        const auto w = StringView(word);
+        return w.find('W') != StringView::npos ||
+               w.find('K') != StringView::npos ||
+               w.find("CZ") != StringView::npos;
+    }
+
+    auto add(StringView main) -> void { add(main, main); }
+    auto add(StringView main, StringView alt) -> void
+    {
+        keys.primary += main;
+        keys.alternate += alt;
+    }
+
+    auto encode_c(int pos) -> int;
+    auto encode_g(int pos) -> int;
+    auto encode_j(int pos) -> int;
+    auto encode_s(int pos) -> int;
+    auto encode_w(int pos) -> int;
+
+    StringType word;
+    Keys keys;
+};
+
+//------------------------------------------------------------------------
+auto Encoder::encode() -> Keys
+{
+    const auto last = length() - 1;
+
+    // Silent first letter
+    int pos = is_at(0, 2, {"GN", "KN", "PN", "WR", "PS"}) ? 1 : 0;
+
+    // Initial 'X' is pronounced 'Z' e.g. "Xavier"
+    if (at(0) == 'X')
+    {
+        add("S");
+        pos = 1;
+    }
+
+    while (pos < length() && (keys.primary.size() < MAX_KEY_LENGTH ||
+                              keys.alternate.size() < MAX_KEY_LENGTH))
+    {
+        const auto next_is = [&](char c) { return at(pos + 1) == c; };
+
+        switch (at(pos))
+        {
+            case 'A':
+            case 'E':
+            case 'I':
+            case 'O':
+            case 'U':
+            case 'Y':
+                // Only the initial vowel is kept
+                if (pos == 0)
+                    add("A");
+                pos++;
+                break;
+            case 'B':
+                add("P");
+                pos += next_is('B') ? 2 : 1;
+                break;
+            case 'C': pos = encode_c(pos); break;
+            case 'D':
+                if (is_at(pos, 2, {"DG"}))
+                {
+                    // "edge" vs. "edgar"
+                    if (is_at(pos + 2, 1, {"I", "E", "Y"}))
+                    {
+                        add("J");
+                        pos += 3;
+                    }
+                    else
+                    {
+                        add("TK");
+                        pos += 2;
+                    }
+                    break;
+                }
+
+                add("T");
+                pos += is_at(pos, 2, {"DT", "DD"}) ? 2 : 1;
+                break;
+            case 'F':
+                add("F");
+                pos += next_is('F') ? 2 : 1;
+                break;
+            case 'G': pos = encode_g(pos); break;
+            case 'H':
+                // Only kept if initial or between two vowels
+                if ((pos == 0 || is_vowel(pos - 1)) && is_vowel(pos + 1))
+                {
+                    add("H");
+                    pos += 2;
+                }
+                else
+                {
+                    pos++;
+                }
+                break;
+            case 'J': pos = encode_j(pos); break;
+            case 'K':
+                add("K");
+                pos += next_is('K') ? 2 : 1;
+                break;
+            case 'L':
+                if (next_is('L'))
+                {
+                    // Spanish e.g. "cabrillo", "gallegos"
+                    if ((pos == length() - 3 &&
+                         is_at(pos - 1, 4, {"ILLO", "ILLA", "ALLE"})) ||
+                        ((is_at(last - 1, 2, {"AS", "OS"}) ||
+                          is_at(last, 1, {"A", "O"})) &&
+                         is_at(pos - 1, 4, {"ALLE"})))
+                    {
+                        add("L", "");
+                        pos += 2;
+                        break;
+                    }
+                    pos += 2;
+                }
+                else
+                {
+                    pos++;
+                }
+                add("L");
+                break;
+            case 'M':
+                // "dumb", "thumbs" but not "umbrella"
+                if ((is_at(pos - 1, 3, {"UMB"}) &&
+                     (pos + 1 == last || is_at(pos + 2, 2, {"ER"}))) ||
+                    next_is('M'))
+                    pos += 2;
+                else
+                    pos++;
+                add("M");
+                break;
+            case 'N':
+                add("N");
+                pos += next_is('N') ? 2 : 1;
+                break;
+            case 'P':
+                if (next_is('H'))
+                {
+                    add("F");
+                    pos += 2;
+                    break;
+                }
+
+                // "campbell", "raspberry"
+                add("P");
+                pos += is_at(pos + 1, 1, {"P", "B"}) ? 2 : 1;
+                break;
+            case 'Q':
+                add("K");
+                pos += next_is('Q') ? 2 : 1;
+                break;
+            case 'R':
+                // French e.g. "rogier", but not "hochmeier"
+                if (pos == last && !is_slavo_germanic() &&
+                    is_at(pos - 2, 2, {"IE"}) &&
+                    !is_at(pos - 4, 2, {"ME", "MA"}))
+                    add("", "R");
+                else
+                    add("R");
+                pos += next_is('R') ? 2 : 1;
+                break;
+            case 'S': pos = encode_s(pos); break;
+            case 'T':
+                if (is_at(pos, 4, {"TION"}) || is_at(pos, 3, {"TIA", "TCH"}))
+                {
+                    add("X");
+                    pos += 3;
+                    break;
+                }
+
+                if (is_at(pos, 2, {"TH"}) || is_at(pos, 3, {"TTH"}))
+                {
+                    // "thomas", "thames" or Germanic
+                    if (is_at(pos + 2, 2, {"OM", "AM"}) ||
+                        is_at(0, 3, {"SCH"}))
+                        add("T");
+                    else
+                        add("0", "T");
+                    pos += 2;
+                    break;
+                }
+
+                add("T");
+                pos += is_at(pos + 1, 1, {"T", "D"}) ? 2 : 1;
+                break;
+            case 'V':
+                add("F");
+                pos += next_is('V') ? 2 : 1;
+                break;
+            case 'W': pos = encode_w(pos); break;
+            case 'X':
+                // French e.g. "breaux"
+                if (!(pos == last && (is_at(pos - 3, 3, {"IAU", "EAU"}) ||
+                                      is_at(pos - 2, 2, {"AU", "OU"}))))
+                    add("KS");
+                pos += is_at(pos + 1, 1, {"C", "X"}) ? 2 : 1;
+                break;
+            case 'Z':
+                // Chinese pinyin e.g. "zhao"
+                if (next_is('H'))
+                {
+                    add("J");
+                    pos += 2;
+                    break;
+                }
+
+                if (is_at(pos + 1, 2, {"ZO", "ZI", "ZA"}) ||
+                    (is_slavo_germanic() && pos > 0 && at(pos - 1) != 'T'))
+                    add("S", "TS");
+                else
+                    add("S");
+                pos += next_is('Z') ? 2 : 1;
+                break;
+            default: pos++; break;
+        }
+    }
+
+    keys.primary.resize(std::min(keys.primary.size(), MAX_KEY_LENGTH));
+    keys.alternate.resize(std::min(keys.alternate.size(), MAX_KEY_LENGTH));
+
+    return std::move(keys);
+}
+
+//------------------------------------------------------------------------
+auto Encoder::encode_c(int pos) -> int
+{
+    // Various Germanic e.g. "bach", "macher"
+    if (pos > 1 && !is_vowel(pos - 2) && is_at(pos - 1, 3, {"ACH"}) &&
+        at(pos + 2) != 'I' &&
+        (at(pos + 2) != 'E' || is_at(pos - 2, 6, {"BACHER", "MACHER"})))
+    {
+        add("K");
+        return pos + 2;
+    }
+
+    if (pos == 0 && is_at(pos, 6, {"CAESAR"}))
+    {
+        add("S");
+        return pos + 2;
+    }
+
+    // Italian "chianti"
+    if (is_at(pos, 4, {"CHIA"}))
+    {
+        add("K");
+        return pos + 2;
+    }
+
+    if (is_at(pos, 2, {"CH"}))
+    {
+        // "michael"
+        if (pos > 0 && is_at(pos, 4, {"CHAE"}))
+        {
+            add("K", "X");
+            return pos + 2;
+        }
+
+        // Greek roots e.g. "chemistry", "chorus"
+        if (pos == 0 &&
+            (is_at(pos + 1, 5, {"HARAC", "HARIS"}) ||
+             is_at(pos + 1, 3, {"HOR", "HYM", "HIA", "HEM"})) &&
+            !is_at(0, 5, {"CHORE"}))
+        {
+            add("K");
+            return pos + 2;
+        }
+
+        // Germanic, Greek or otherwise 'ch' for 'kh' sound
+        if (is_at(0, 3, {"SCH"}) ||
+            is_at(pos - 2, 6, {"ORCHES", "ARCHIT", "ORCHID"}) ||
+            is_at(pos + 2, 1, {"T", "S"}) ||
+            ((is_at(pos - 1, 1, {"A", "O", "U", "E"}) || pos == 0) &&
+             (pos + 2 == length() ||
+              is_at(pos + 2, 1,
+                    {"L", "R", "N", "M", "B", "H", "F", "V", "W"}))))
+            add("K");
+        else if (pos == 0)
+            add("X");
+        else if (is_at(0, 2, {"MC"}))
+            add("K");
+        else
+            add("X", "K");
+
+        return pos + 2;
+    }
+
+    // "czerny"
+    if (is_at(pos, 2, {"CZ"}) && !is_at(pos - 2, 4, {"WICZ"}))
+    {
+        add("S", "X");
+        return pos + 2;
+    }
+
+    // "focaccia"
+    if (is_at(pos + 1, 3, {"CIA"}))
+    {
+        add("X");
+        return pos + 3;
+    }
+
+    // Double 'C', but not e.g. "McClellan"
+    if (is_at(pos, 2, {"CC"}) && !(pos == 1 && at(0) == 'M'))
+    {
+        // "bellocchio" but not "bacchus"
+        if (is_at(pos + 2, 1, {"I", "E", "H"}) && !is_at(pos + 2, 2, {"HU"}))
+        {
+            // "accident", "accede", "succeed" vs. "bacci", "bertucci"
+            if ((pos == 1 && at(0) == 'A') ||
+                is_at(pos - 1, 5, {"UCCEE", "UCCES"}))
+                add("KS");
+            else
+                add("X");
+            return pos + 3;
+        }
+
+        add("K");
+        return pos + 2;
+    }
+
+    if (is_at(pos, 2, {"CK", "CG", "CQ"}))
+    {
+        add("K");
+        return pos + 2;
+    }
+
+    if (is_at(pos, 2, {"CI", "CE", "CY"}))
+    {
+        // Italian vs. English
+        if (is_at(pos, 3, {"CIO", "CIE", "CIA"}))
+            add("S", "X");
+        else
+            add("S");
+        return pos + 2;
+    }
+
+    add("K");
+    if (is_at(pos + 1, 1, {"C", "K", "Q"}) && !is_at(pos + 1, 2, {"CE", "CI"}))
+        return pos + 2;
+
+    return pos + 1;
+}
+
+//------------------------------------------------------------------------
+auto Encoder::encode_g(int pos) -> int
+{
+    if (at(pos + 1) == 'H')
+    {
+        if (pos > 0 && !is_vowel(pos - 1))
+        {
+            add("K");
+            return pos + 2;
+        }
+
+        // "ghislane", "ghiradelli"
+        if (pos == 0)
+        {
+            add(at(pos + 2) == 'I' ? "J" : "K");
+            return pos + 2;
+        }
+
+        // Parker's rule e.g. "hugh"
+        if (is_at(pos - 2, 1, {"B", "H", "D"}) ||
+            is_at(pos - 3, 1, {"B", "H", "D"}) ||
+            is_at(pos - 4, 1, {"B", "H"}))
+            return pos + 2;
+
+        // "laugh", "mclaughlin", "cough", "rough", "tough"
+        if (pos > 2 && at(pos - 1) == 'U' &&
+            is_at(pos - 3, 1, {"C", "G", "L", "R", "T"}))
+            add("F");
+        else if (at(pos - 1) != 'I')
+            add("K");
+
+        return pos + 2;
+    }
+
+    if (at(pos + 1) == 'N')
+    {
+        if (pos == 1 && is_vowel(0) && !is_slavo_germanic())
+            add("KN", "N");
+        else if (!is_at(pos + 2, 2, {"EY"}) && !is_slavo_germanic())
+            add("N", "KN");
+        else
+            add("KN");
+
+        return pos + 2;
+    }
+
+    // "tagliaro"
+    if (is_at(pos + 1, 2, {"LI"}) && !is_slavo_germanic())
+    {
+        add("KL", "L");
+        return pos + 2;
+    }
+
+    // -ges-, -gep-, -gel-, -gie- at the beginning
+    if (pos == 0 && (at(pos + 1) == 'Y' ||
+                     is_at(pos + 1, 2,
+                           {"ES", "EP", "EB", "EL", "EY", "IB", "IL", "IN",
+                            "IE", "EI", "ER"})))
+    {
+        add("K", "J");
+        return pos + 2;
+    }
+
+    // -ger-, -gy-
+    if ((is_at(pos + 1, 2, {"ER"}) || at(pos + 1) == 'Y') &&
+        !is_at(0, 6, {"DANGER", "RANGER", "MANGER"}) &&
+        !is_at(pos - 1, 1, {"E", "I"}) && !is_at(pos - 1, 3, {"RGY", "OGY"}))
+    {
+        add("K", "J");
+        return pos + 2;
+    }
+
+    // Italian e.g. "biaggi"
+    if (is_at(pos + 1, 1, {"E", "I", "Y"}) ||
+        is_at(pos - 1, 4, {"AGGI", "OGGI"}))
+    {
+        if (is_at(0, 3, {"SCH"}) || is_at(pos + 1, 2, {"ET"}))
+            add("K");
+        else if (is_at(pos + 1, 3, {"IER"}) && pos + 4 == length())
+            add("J");
+        else
+            add("J", "K");
+
+        return pos + 2;
+    }
+
+    add("K");
+    return at(pos + 1) == 'G' ? pos + 2 : pos + 1;
+}
+
+//------------------------------------------------------------------------
+auto Encoder::encode_j(int pos) -> int
+{
+    // Spanish "jose"
+    if (is_at(pos, 4, {"JOSE"}))
+    {
+        if (pos == 0 && pos + 4 == length())
+            add("H");
+        else
+            add("J", "H");
+        return pos + 1;
+    }
+
+    if (pos == 0)
+    {
+        // "yankelovich" vs. "jankelowicz"
+        add("J", "A");
+    }
+    else if (is_vowel(pos - 1) && !is_slavo_germanic() &&
+             (at(pos + 1) == 'A' || at(pos + 1) == 'O'))
+    {
+        // Spanish e.g. "bajador"
+        add("J", "H");
+    }
+    else if (pos == length() - 1)
+    {
+        add("J", "");
+    }
+    else if (!is_at(pos + 1, 1, {"L", "T", "K", "S", "N", "M", "B", "Z"}) &&
+             !is_at(pos - 1, 1, {"S", "K", "L"}))
+    {
+        add("J");
+    }
+
+    return at(pos + 1) == 'J' ? pos + 2 : pos + 1;
+}
+
+//------------------------------------------------------------------------
+auto Encoder::encode_s(int pos) -> int
+{
+    // "island", "isle", "carlisle", "carlysle"
+    if (is_at(pos - 1, 3, {"ISL", "YSL"}))
+        return pos + 1;
+
+    // "sugar"
+    if (pos == 0 && is_at(pos, 5, {"SUGAR"}))
+    {
+        add("X", "S");
+        return pos + 1;
+    }
+
+    if (is_at(pos, 2, {"SH"}))
+    {
+        // Germanic
+        if (is_at(pos + 1, 4, {"HEIM", "HOEK", "HOLM", "HOLZ"}))
+            add("S");
+        else
+            add("X");
+        return pos + 2;
+    }
+
+    // Italian and Armenian
+    if (is_at(pos, 3, {"SIO", "SIA"}) || is_at(pos, 4, {"SIAN"}))
+    {
+        if (is_slavo_germanic())
+            add("S");
+        else
+            add("S", "X");
+        return pos + 3;
+    }
+
+    // German and anglicisations e.g. "smith" matches "schmidt", "snider"
+    // matches "schneider". Also -sz- in Slavic languages.
+    if ((pos == 0 && is_at(pos + 1, 1, {"M", "N", "L", "W"})) ||
+        is_at(pos + 1, 1, {"Z"}))
+    {
+        add("S", "X");
+        return is_at(pos + 1, 1, {"Z"}) ? pos + 2 : pos + 1;
+    }
+
+    if (is_at(pos, 2, {"SC"}))
+    {
+        // Schlesinger's rule
+        if (at(pos + 2) == 'H')
+        {
+            // Dutch origin e.g. "school", "schooner"
+            if (is_at(pos + 3, 2, {"OO", "ER", "EN", "UY", "ED", "EM"}))
+            {
+                // "schermerhorn", "schenker"
+                if (is_at(pos + 3, 2, {"ER", "EN"}))
+                    add("X", "SK");
+                else
+                    add("SK");
+                return pos + 3;
+            }
+
+            if (pos == 0 && !is_vowel(3) && at(3) != 'W')
+                add("X", "S");
+            else
+                add("X");
+            return pos + 3;
+        }
+
+        if (is_at(pos + 2, 1, {"I", "E", "Y"}))
+            add("S");
+        else
+            add("SK");
+        return pos + 3;
+    }
+
+    // French e.g. "resnais", "artois"
+    if (pos == length() - 1 && is_at(pos - 2, 2, {"AI", "OI"}))
+        add("", "S");
+    else
+        add("S");
+
+    return is_at(pos + 1, 1, {"S", "Z"}) ? pos + 2 : pos + 1;
+}
+
+//------------------------------------------------------------------------
+auto Encoder::encode_w(int pos) -> int
+{
+    if (is_at(pos, 2, {"WR"}))
+    {
+        add("R");
+        return pos + 2;
+    }
+
+    // "wasserman" matches "vasserman", "uomo" matches "womo"
+    if (pos == 0 && (is_vowel(pos + 1) || is_at(pos, 2, {"WH"})))
+    {
+        if (is_vowel(pos + 1))
+            add("A", "F");
+        else
+            add("A");
+    }
+
+    // "arnow" matches "arnoff"
+    if ((pos == length() - 1 && is_vowel(pos - 1)) ||
+        is_at(pos - 1, 5, {"EWSKI", "EWSKY", "OWSKI", "OWSKY"}) ||
+        is_at(0, 3, {"SCH"}))
+    {
+        add("", "F");
+        return pos + 1;
+    }
+
+    // Polish e.g. "filipowicz"
+    if (is_at(pos, 4, {"WICZ", "WITZ"}))
+    {
+        add("TS", "FX");
+        return pos + 4;
+    }
+
+    return pos + 1;
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+auto encode(StringView word) -> Keys
+{
+    auto latin = transliterate(word);
+    if (latin.empty())
+    {
+        // Numbers and non Latin scripts, '#' keeps them apart from real keys
+        auto key = "#" + StringType(word);
+        return {key, key};
+    }
+
+    return Encoder(std::move(latin)).encode();
+}
+
+//------------------------------------------------------------------------
+auto is_match(const Keys& keys0, const Keys& keys1) -> bool
+{
+    const auto equals = [](const StringType& key0, const StringType& key1) {
+        return !key0.empty() && key0 == key1;
+    };
+
+    return equals(keys0.primary, keys1.primary) ||
+           equals(keys0.primary, keys1.alternate) ||
+           equals(keys0.alternate, keys1.primary) ||
+           equals(keys0.alternate, keys1.alternate);
+}
+
+//------------------------------------------------------------------------
+} // namespace mam::double_metaphone
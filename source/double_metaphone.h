@@ -0,0 +1,34 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "wordify_types.h"
+#include <string_view>
+
+namespace mam::double_metaphone {
+//------------------------------------------------------------------------
+// Double Metaphone after Lawrence Philips (2000). Encodes how a word sounds
+// in English, so "Kathryn" and "Catherine" share the key "K0RN". Words of
+// ambiguous origin get an alternate key e.g. "Schmidt" is "XMT" or "SMT".
+//
+// Works on Latin letters only, accented ones are transliterated. Words
+// without any Latin letter, like numbers, are their own key.
+//------------------------------------------------------------------------
+using StringView = std::string_view;
+
+constexpr size_t MAX_KEY_LENGTH = 4;
+
+struct Keys
+{
+    StringType primary;
+    StringType alternate; // Same as primary if there is no alternative
+};
+
+/** The word must be normalized already, see text_normalizer */
+auto encode(StringView word) -> Keys;
+
+/** Any key of the one word equals any key of the other */
+auto is_match(const Keys& keys0, const Keys& keys1) -> bool;
+
+//------------------------------------------------------------------------
+} // namespace mam::double_metaphone
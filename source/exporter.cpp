@@ -2,189 +2,559 @@
 
 #include "exporter.h"
 #include "warn_cpp/suppress_warnings.h"
-#include <chrono>
-#include <fstream>
-#include <iostream>
-#include <nlohmann/json.hpp>
-#include <sstream>
+#include <algorithm>
+#include <cmath>
 BEGIN_SUPPRESS_WARNINGS
 #include "fmt/format.h"
 END_SUPPRESS_WARNINGS
 
 namespace mam::exporter {
-static auto trim(StringType& str) -> StringType
+namespace {
+
+//------------------------------------------------------------------------
+constexpr char kCommaSeparator = ',';
+constexpr char kDotSeparator   = '.';
+
+//------------------------------------------------------------------------
+auto to_timestamp(Seconds seconds, char separator) -> StringType
 {
-    if (str.empty())
-        return str;
+    const auto total_ms =
+        static_cast<int64_t>(std::llround(std::max(seconds, 0.) * 1000.));
+    const auto h  = total_ms / 3600000;
+    const auto m  = total_ms / 60000 % 60;
+    const auto s  = total_ms / 1000 % 60;
+    const auto ms = total_ms % 1000;
+
+    return fmt::format("{:02}:{:02}:{:02}{}{:03}", h, m, s, separator, ms);
+}
 
-    if (std::isspace(str.front()) != 0)
-        str.erase(str.begin());
-    if (std::isspace(str.back()))
-        str.pop_back();
+//------------------------------------------------------------------------
+auto count_chars(StringView text) -> size_t
+{
+    // UTF-8 continuation bytes do not start a character
+    return static_cast<size_t>(std::count_if(
+        text.begin(), text.end(), [](char c) { return (c & 0xc0) != 0x80; }));
+}
 
-    return str;
+//------------------------------------------------------------------------
+template <typename Func>
+auto for_each_word(const RegionData& region, Func&& func) -> void
+{
+    const auto& words = region.words;
+    for (auto i = words.first(); i < words.last(); i++)
+    {
+        if (!words.is_clipped_by_region(i))
+            func(i);
+    }
 }
 
-namespace subrip {
+//------------------------------------------------------------------------
+using EscapeFunc = StringType (*)(StringView text);
 
-template <typename T>
-auto to_time_display_string(T seconds) -> StringType
+auto write_spoken_text(const RegionData& region,
+                       BufferedWriter& out,
+                       EscapeFunc escape) -> void
 {
-    namespace chrono = std::chrono;
+    bool is_first = true;
+    for_each_word(region, [&](Index i) {
+        if (!is_first)
+            out.write(' ');
+
+        out.write(escape(region.words.text(i)));
+        is_first = false;
+    });
+}
 
-    chrono::seconds total(static_cast<size_t>(seconds));
-    const auto h = chrono::duration_cast<chrono::hours>(total);
-    const auto m = chrono::duration_cast<chrono::minutes>(total - h);
-    const auto s = chrono::duration_cast<chrono::seconds>(total - h - m);
-    const auto ms =
-        chrono::duration_cast<chrono::milliseconds>(total - h - m - s);
+//------------------------------------------------------------------------
+auto escape_none(StringView text) -> StringType
+{
+    return StringType(text);
+}
 
-    auto output = fmt::format("{:02}:{:02}:{:02},{:03}", h.count(), m.count(),
-                              s.count(), ms.count());
+//------------------------------------------------------------------------
+auto escape_json(StringView text) -> StringType
+{
+    StringType escaped;
+    escaped.reserve(text.size());
+    for (const char c : text)
+    {
+        switch (c)
+        {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '\r':
+                escaped += "\\r";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    escaped += fmt::format("\\u{:04x}", int(c));
+                else
+                    escaped += c;
+        }
+    }
 
-    return output;
+    return escaped;
 }
 
-struct SubTitle
+//------------------------------------------------------------------------
+auto escape_xml(StringView text) -> StringType
 {
-    StringType start_time;
-    StringType end_time;
-    StringType text;
-};
+    // Text content only, never attribute values, so quotes can stay
+    StringType escaped;
+    escaped.reserve(text.size());
+    for (const char c : text)
+    {
+        switch (c)
+        {
+            case '&':
+                escaped += "&amp;";
+                break;
+            case '<':
+                escaped += "&lt;";
+                break;
+            case '>':
+                escaped += "&gt;";
+                break;
+            default:
+                escaped += c;
+        }
+    }
+
+    return escaped;
+}
 
-using SubTitles = std::vector<SubTitle>;
+//------------------------------------------------------------------------
+auto escape_csv(StringView text) -> StringType
+{
+    // RFC 4180, quotes are doubled inside quoted fields
+    StringType escaped = "\"";
+    for (const char c : text)
+    {
+        if (c == '"')
+            escaped += '"';
+
+        escaped += c;
+    }
 
+    return escaped + '"';
+}
+
+//------------------------------------------------------------------------
 // https://en.wikipedia.org/wiki/SubRip
-constexpr auto kArrow = " --> ";
+//------------------------------------------------------------------------
+class SubRipWriter : public FormatWriter
+{
+public:
+    //--------------------------------------------------------------------
+    auto write_cue(const Cue& cue, BufferedWriter& out) -> void override
+    {
+        out.write(fmt::format("{}\n{} --> {}\n", ++counter,
+                              to_timestamp(cue.begin, kCommaSeparator),
+                              to_timestamp(cue.end, kCommaSeparator)));
+        out.write(cue.text).write("\n\n");
+    }
+
+    //--------------------------------------------------------------------
+private:
+    size_t counter = 0;
+};
 
-static auto do_export(const PathType& output_path, const SubTitles& sub_titles)
-    -> bool
+//------------------------------------------------------------------------
+// https://www.w3.org/TR/webvtt1/
+//------------------------------------------------------------------------
+class WebVTTWriter : public FormatWriter
 {
-    using OFStream = std::ofstream;
-    OFStream out_stream(output_path);
+public:
+    //--------------------------------------------------------------------
+    auto begin(BufferedWriter& out) -> void override
+    {
+        out.write("WEBVTT\n\n");
+    }
 
-    size_t counter = 1;
-    for (const auto& el : sub_titles)
+    auto write_cue(const Cue& cue, BufferedWriter& out) -> void override
     {
-        out_stream << counter << std::endl;
-        out_stream << el.start_time << kArrow << el.end_time << std::endl;
-        out_stream << el.text << std::endl;
-        out_stream << std::endl;
+        out.write(fmt::format("{} --> {}\n",
+                              to_timestamp(cue.begin, kDotSeparator),
+                              to_timestamp(cue.end, kDotSeparator)));
+
+        // The voice span names the speaker
+        if (!cue.speaker.empty())
+            out.write("<v ").write(escape_xml(cue.speaker)).write('>');
 
-        counter++;
+        out.write(escape_xml(cue.text)).write("\n\n");
     }
+};
 
-    return true;
-}
-} // namespace subrip
+//------------------------------------------------------------------------
+// https://www.w3.org/TR/ttml2/
+//------------------------------------------------------------------------
+class TTMLWriter : public FormatWriter
+{
+public:
+    //--------------------------------------------------------------------
+    auto begin(BufferedWriter& out) -> void override
+    {
+        out.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                  "<tt xmlns=\"http://www.w3.org/ns/ttml\">\n"
+                  "  <body>\n"
+                  "    <div>\n");
+    }
+
+    auto write_cue(const Cue& cue, BufferedWriter& out) -> void override
+    {
+        StringType text = escape_xml(cue.text);
+        for (auto pos = text.find('\n'); pos != StringType::npos;
+             pos      = text.find('\n', pos))
+            text.replace(pos, 1, "<br/>");
+
+        out.write(fmt::format("      <p begin=\"{}\" end=\"{}\">",
+                              to_timestamp(cue.begin, kDotSeparator),
+                              to_timestamp(cue.end, kDotSeparator)));
+        out.write(text).write("</p>\n");
+    }
+
+    auto end(BufferedWriter& out) -> void override
+    {
+        out.write("    </div>\n"
+                  "  </body>\n"
+                  "</tt>\n");
+    }
+};
+
+//------------------------------------------------------------------------
+// One paragraph per region, headed by its speaker and start time
+//------------------------------------------------------------------------
+class PlainTextWriter : public FormatWriter
+{
+public:
+    //--------------------------------------------------------------------
+    auto write_region(const RegionData& region,
+                      BufferedWriter& out,
+                      Segmenter& /*segmenter*/) -> void override
+    {
+        if (!region.name.empty())
+            out.write(region.name).write(' ');
+
+        out.write('[')
+            .write(to_timestamp(region.project_time_start, kDotSeparator))
+            .write("]\n");
+        write_spoken_text(region, out, escape_none);
+        out.write("\n\n");
+    }
+};
 
-namespace json {
-auto do_export(const PathType& output_path, const RegionDataList& regions)
-    -> bool
+//------------------------------------------------------------------------
+// One row per word
+//------------------------------------------------------------------------
+class CSVWriter : public FormatWriter
 {
-    nlohmann::json transcript;
+public:
+    //--------------------------------------------------------------------
+    auto begin(BufferedWriter& out) -> void override
+    {
+        out.write("speaker,start_time,end_time,word\n");
+    }
 
-    for (const auto& region : regions)
+    auto write_region(const RegionData& region,
+                      BufferedWriter& out,
+                      Segmenter& /*segmenter*/) -> void override
     {
-        const auto& words_data = region;
+        const auto speaker = escape_csv(region.name);
+        for_each_word(region, [&](Index i) {
+            const auto begin = region.words.begin(i) + region.project_offset;
+            const auto end   = begin + region.words.duration(i);
+            out.write(fmt::format("{},{:.3f},{:.3f},", speaker, begin, end));
+            out.write(escape_csv(region.words.text(i))).write('\n');
+        });
+    }
+};
 
-        StringType speaker    = words_data.name;
-        StringType start_time = std::to_string(words_data.project_time_start);
-        StringType duration   = std::to_string(words_data.duration);
+//------------------------------------------------------------------------
+// One entry per region with its spoken text and all of its words
+//------------------------------------------------------------------------
+class JSONWriter : public FormatWriter
+{
+public:
+    //--------------------------------------------------------------------
+    auto begin(BufferedWriter& out) -> void override
+    {
+        out.write("{\n    \"transcript\": [");
+    }
 
-        const auto& words = words_data.words;
-        StringType spoken_text;
-        for (const auto& word : words)
-        {
-            if (word.is_clipped_by_region)
-                continue;
+    auto write_region(const RegionData& region,
+                      BufferedWriter& out,
+                      Segmenter& /*segmenter*/) -> void override
+    {
+        out.write(is_first_region ? "\n" : ",\n");
+        is_first_region = false;
+
+        out.write(fmt::format("        {{\n"
+                              "            \"speaker\": \"{}\",\n"
+                              "            \"start_time\": \"{}\",\n"
+                              "            \"duration\": \"{}\",\n"
+                              "            \"spoken_text\": \"",
+                              escape_json(region.name),
+                              std::to_string(region.project_time_start),
+                              std::to_string(region.duration)));
+        write_spoken_text(region, out, escape_json);
+        out.write("\",\n            \"words\": [");
+
+        bool is_first_word = true;
+        for_each_word(region, [&](Index i) {
+            const auto begin = region.words.begin(i) + region.project_offset;
+            out.write(is_first_word ? "\n" : ",\n");
+            out.write(fmt::format("                {{\"word\": \"{}\", "
+                                  "\"start_time\": {:.3f}, "
+                                  "\"duration\": {:.3f}}}",
+                                  escape_json(region.words.text(i)), begin,
+                                  region.words.duration(i)));
+            is_first_word = false;
+        });
+
+        out.write(is_first_word ? "]" : "\n            ]");
+        out.write("\n        }");
+    }
 
-            spoken_text += word.word.value + " ";
-        }
+    auto end(BufferedWriter& out) -> void override
+    {
+        out.write(is_first_region ? "]\n}\n" : "\n    ]\n}\n");
+    }
+
+    //--------------------------------------------------------------------
+private:
+    bool is_first_region = true;
+};
+
+//------------------------------------------------------------------------
+template <typename Writer>
+auto create_writer() -> FormatWriterPtr
+{
+    return std::make_unique<Writer>();
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// BufferedWriter
+//------------------------------------------------------------------------
+BufferedWriter::BufferedWriter(const PathType& path)
+: stream(path)
+{
+    buffer.reserve(BUFFER_SIZE);
+}
+
+//------------------------------------------------------------------------
+BufferedWriter::~BufferedWriter()
+{
+    flush();
+}
 
-        nlohmann::json speaker_data = {{"speaker", speaker},
-                                       {"start_time", start_time},
-                                       {"duration", duration},
-                                       {"spoken_text", trim(spoken_text)}};
+//------------------------------------------------------------------------
+auto BufferedWriter::write(StringView s) -> BufferedWriter&
+{
+    if (buffer.size() + s.size() > BUFFER_SIZE)
+        write_buffer();
+
+    // Too large to be buffered at all
+    if (s.size() > BUFFER_SIZE)
+        stream.write(s.data(), static_cast<std::streamsize>(s.size()));
+    else
+        buffer.append(s);
 
-        transcript["transcript"].push_back(speaker_data);
+    return *this;
+}
+
+//------------------------------------------------------------------------
+auto BufferedWriter::write(char c) -> BufferedWriter&
+{
+    return write(StringView(&c, 1));
+}
+
+//------------------------------------------------------------------------
+auto BufferedWriter::flush() -> bool
+{
+    write_buffer();
+    stream.flush();
+
+    return stream.good();
+}
+
+//------------------------------------------------------------------------
+auto BufferedWriter::write_buffer() -> void
+{
+    stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+//------------------------------------------------------------------------
+// Segmenter
+//------------------------------------------------------------------------
+Segmenter::Segmenter(const SegmentationLimits& limits, CueFunc&& on_cue)
+: limits(limits)
+, on_cue(std::move(on_cue))
+{
+}
+
+//------------------------------------------------------------------------
+auto Segmenter::add_region(const RegionData& region) -> void
+{
+    // Words reaching into the region are cut at its borders
+    const auto region_begin = region.project_time_start;
+    const auto region_end   = region.project_time_start + region.duration;
+
+    cue.speaker = region.name;
+    for_each_word(region, [&](Index i) {
+        const auto begin = region.words.begin(i) + region.project_offset;
+        const auto end   = begin + region.words.duration(i);
+        add_word(region.words.text(i), std::max(begin, region_begin),
+                 std::max(std::min(end, region_end), region_begin));
+    });
+
+    finish_cue();
+}
+
+//------------------------------------------------------------------------
+auto Segmenter::add_word(StringView text, Seconds begin, Seconds end) -> void
+{
+    if (num_lines == 0)
+        return start_cue(text, begin, end);
+
+    if (end - cue.begin > limits.max_duration)
+    {
+        finish_cue();
+        return start_cue(text, begin, end);
     }
 
-    auto& filePath = output_path;
-    std::ofstream file(filePath);
-    if (file.is_open())
+    const auto length = count_chars(text);
+    if (line_length + 1 + length <= limits.max_chars_per_line)
     {
-        file << std::setw(4) << transcript << std::endl;
-        file.close();
-        std::cout << "JSON file saved to: " << filePath << std::endl;
+        cue.text += ' ';
+        line_length += 1 + length;
+    }
+    else if (num_lines < limits.max_lines)
+    {
+        cue.text += '\n';
+        line_length = length;
+        num_lines++;
     }
     else
     {
-        std::cerr << "Unable to open file for writing!" << std::endl;
+        finish_cue();
+        return start_cue(text, begin, end);
     }
 
-    return true;
+    cue.text.append(text);
+    cue.end = std::max(cue.end, end);
 }
 
-} // namespace json
+//------------------------------------------------------------------------
+auto Segmenter::start_cue(StringView text, Seconds begin, Seconds end) -> void
+{
+    cue.text.assign(text);
+    cue.begin   = begin;
+    cue.end     = end;
+    num_lines   = 1;
+    line_length = count_chars(text);
+}
 
-static auto convert(const RegionDataList& regions,
-                    subrip::SubTitles& sub_titles) -> void
+//------------------------------------------------------------------------
+auto Segmenter::finish_cue() -> void
 {
-    for (const auto& region : regions)
-    {
-        subrip::SubTitle sub_title;
-        sub_title.start_time =
-            subrip::to_time_display_string(region.project_time_start);
-        sub_title.end_time = subrip::to_time_display_string(
-            region.project_time_start + region.duration);
-        for (const auto& word : region.words)
-        {
-            if (word.is_clipped_by_region)
-                continue;
+    if (num_lines == 0)
+        return;
 
-            sub_title.text += word.word.value + ' ';
-        }
-        sub_title.text = trim(sub_title.text);
+    on_cue(cue);
+    cue.text.clear();
+    num_lines = 0;
+}
 
-        sub_titles.emplace_back(sub_title);
-    }
+//------------------------------------------------------------------------
+// FormatWriter
+//------------------------------------------------------------------------
+auto FormatWriter::write_region(const RegionData& region,
+                                BufferedWriter& /*out*/,
+                                Segmenter& segmenter) -> void
+{
+    segmenter.add_region(region);
+}
+
+//------------------------------------------------------------------------
+auto get_format_registry() -> const FormatRegistry&
+{
+    static const FormatRegistry registry = {
+        {Format::JSON, {"JSON", "json"}, create_writer<JSONWriter>},
+        {Format::SRT, {"SubRip", "srt"}, create_writer<SubRipWriter>},
+        {Format::WebVTT, {"WebVTT", "vtt"}, create_writer<WebVTTWriter>},
+        {Format::TTML, {"TTML", "ttml"}, create_writer<TTMLWriter>},
+        {Format::PlainText,
+         {"Plain Text", "txt"},
+         create_writer<PlainTextWriter>},
+        {Format::CSV, {"CSV", "csv"}, create_writer<CSVWriter>},
+    };
+
+    return registry;
+}
+
+//------------------------------------------------------------------------
+static auto find_format(Format format) -> const FormatEntry*
+{
+    const auto& registry = get_format_registry();
+    const auto iter =
+        std::find_if(registry.begin(), registry.end(), [format](const auto& e) {
+            return e.format == format;
+        });
+
+    return iter != registry.end() ? &*iter : nullptr;
 }
 
+//------------------------------------------------------------------------
 auto do_export(const PathType& output_path,
                const RegionDataList& regions,
-               Format format) -> bool
+               Format format,
+               const SegmentationLimits& limits) -> bool
 {
-    switch (format)
-    {
-        case Format::SRT: {
-            subrip::SubTitles sub_titles;
-            sub_titles.reserve(regions.size());
-            convert(regions, sub_titles);
-            return subrip::do_export(output_path, sub_titles);
-        }
+    const auto* entry = find_format(format);
+    if (!entry)
+        return false;
 
-        case Format::JSON: {
-            return json::do_export(output_path, regions);
-        }
+    auto writer = entry->create();
+    BufferedWriter out(output_path);
+    Segmenter segmenter(limits,
+                        [&](const Cue& cue) { writer->write_cue(cue, out); });
 
-        default: {
-            return false;
-        }
-    }
+    writer->begin(out);
+    for (const auto& region : regions)
+        writer->write_region(region, out, segmenter);
+
+    writer->end(out);
+    return out.flush();
 }
 
+//------------------------------------------------------------------------
+auto do_export(const PathType& output_path,
+               const RegionDataList& regions,
+               Format format) -> bool
+{
+    return do_export(output_path, regions, format, SegmentationLimits());
+}
+
+//------------------------------------------------------------------------
 auto getFormatInfo(Format format) -> FormatInfo
 {
-    switch (format)
-    {
-        case Format::SRT:
-            return {"SubRip", "srt"};
-        case Format::JSON:
-            return {"JSON", "json"};
-        default:
-            return {};
-    }
+    const auto* entry = find_format(format);
+    return entry ? entry->info : FormatInfo();
 }
 
-} // namespace mam::exporter
\ No newline at end of file
+//------------------------------------------------------------------------
+} // namespace mam::exporter
@@ -3,7 +3,11 @@
 #pragma once
 
 #include "region_data.h"
+#include <fstream>
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace mam::exporter {
@@ -12,11 +16,17 @@ enum class Format
 {
     JSON,
     SRT, // SubRip
+    WebVTT,
+    TTML,
+    PlainText,
+    CSV,
 };
 
 using StringType     = std::string;
+using StringView     = std::string_view;
 using PathType       = StringType;
 using RegionDataList = std::vector<RegionData>;
+using Seconds        = RegionData::Seconds;
 
 struct FormatInfo
 {
@@ -24,10 +34,138 @@ struct FormatInfo
     StringType extension;
 };
 
+//------------------------------------------------------------------------
+// BufferedWriter
+//
+// Collects the output in a fixed size buffer and hands it to the file in
+// large blocks. Nothing is flushed per line, memory stays bounded no matter
+// how long the export is.
+//------------------------------------------------------------------------
+class BufferedWriter
+{
+public:
+    //--------------------------------------------------------------------
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    explicit BufferedWriter(const PathType& path);
+    ~BufferedWriter();
+
+    auto write(StringView s) -> BufferedWriter&;
+    auto write(char c) -> BufferedWriter&;
+
+    /** False if the file could not be opened or written */
+    auto flush() -> bool;
+
+    //--------------------------------------------------------------------
+private:
+    auto write_buffer() -> void;
+
+    std::ofstream stream;
+    StringType buffer;
+};
+
+//------------------------------------------------------------------------
+// Cue
+//------------------------------------------------------------------------
+struct Cue
+{
+    StringView speaker;
+    Seconds begin = 0.;
+    Seconds end   = 0.;
+    StringType text; // Lines are separated by '\n'
+};
+
+struct SegmentationLimits
+{
+    size_t max_chars_per_line = 42;
+    size_t max_lines          = 2;
+    Seconds max_duration      = 7.;
+};
+
+//------------------------------------------------------------------------
+// Segmenter
+//
+// Splits the words of a region into subtitle cues. Words are put on a line
+// as long as it fits max_chars_per_line (counted in UTF-8 characters), then
+// on the next line. A cue ends when max_lines are full or it would last
+// longer than max_duration. A single word longer than a line gets a line
+// of its own. Cues never span two regions.
+//------------------------------------------------------------------------
+class Segmenter
+{
+public:
+    //--------------------------------------------------------------------
+    using CueFunc = std::function<void(const Cue& cue)>;
+
+    Segmenter(const SegmentationLimits& limits, CueFunc&& on_cue);
+
+    auto add_region(const RegionData& region) -> void;
+
+    //--------------------------------------------------------------------
+private:
+    auto add_word(StringView text, Seconds begin, Seconds end) -> void;
+    auto start_cue(StringView text, Seconds begin, Seconds end) -> void;
+    auto finish_cue() -> void;
+
+    SegmentationLimits limits;
+    CueFunc on_cue;
+    Cue cue;
+    size_t num_lines   = 0;
+    size_t line_length = 0;
+};
+
+//------------------------------------------------------------------------
+// FormatWriter
+//
+// Writes one export format, region by region. Subtitle formats write cues
+// only, they get them from the Segmenter by default.
+//------------------------------------------------------------------------
+class FormatWriter
+{
+public:
+    //--------------------------------------------------------------------
+    virtual ~FormatWriter() = default;
+
+    virtual auto begin(BufferedWriter& /*out*/) -> void {}
+    virtual auto write_region(const RegionData& region,
+                              BufferedWriter& out,
+                              Segmenter& segmenter) -> void;
+    virtual auto write_cue(const Cue& /*cue*/, BufferedWriter& /*out*/)
+        -> void
+    {
+    }
+    virtual auto end(BufferedWriter& /*out*/) -> void {}
+};
+
+using FormatWriterPtr = std::unique_ptr<FormatWriter>;
+
+//------------------------------------------------------------------------
+// Registry of all formats, in the order they are offered to the user. A
+// new format only needs a FormatWriter and an entry here.
+//------------------------------------------------------------------------
+struct FormatEntry
+{
+    using CreateFunc = std::function<FormatWriterPtr()>;
+
+    Format format;
+    FormatInfo info;
+    CreateFunc create;
+};
+
+using FormatRegistry = std::vector<FormatEntry>;
+
+auto get_format_registry() -> const FormatRegistry&;
+
+/** Writes all regions in a single pass, see BufferedWriter */
+auto do_export(const PathType& output_path,
+               const RegionDataList& regions,
+               Format format,
+               const SegmentationLimits& limits) -> bool;
+
 auto do_export(const PathType& output_path,
                const RegionDataList& regions,
                Format format) -> bool;
 
 auto getFormatInfo (Format format) -> FormatInfo;
 
-} // namespace mam::exporter
\ No newline at end of file
+} // namespace mam::exporter
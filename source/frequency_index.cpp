@@ -0,0 +1,133 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "frequency_index.h"
+#include <algorithm>
+
+namespace mam {
+namespace {
+
+//------------------------------------------------------------------------
+auto term_less(const FrequencyIndex::TermCount& lhs,
+               const FrequencyIndex::TermCount& rhs) -> bool
+{
+    return lhs.term < rhs.term;
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// FrequencyIndex
+//------------------------------------------------------------------------
+auto FrequencyIndex::count_terms(const RegionWords& words,
+                                 const SourceIndex* source_index)
+    -> TermCounts
+{
+    // Not indexed yet or outdated
+    if (!source_index || source_index->get_store() != words.get_store())
+        return {};
+
+    std::unordered_map<TermId, size_t> counts;
+    for (auto i = words.first(); i < words.last(); i++)
+    {
+        if (words.is_clipped_by_region(i))
+            continue;
+
+        // Punctuation marks are no terms
+        const auto term = source_index->term(i);
+        if (term != Vocabulary::INVALID_TERM)
+            counts[term]++;
+    }
+
+    TermCounts term_counts;
+    term_counts.reserve(counts.size());
+    for (const auto& [term, count] : counts)
+        term_counts.push_back({term, count});
+
+    std::sort(term_counts.begin(), term_counts.end(), term_less);
+
+    return term_counts;
+}
+
+//------------------------------------------------------------------------
+auto FrequencyIndex::update_region(Id region_id, TermCounts&& counts) -> void
+{
+    auto& previous = regions[region_id];
+
+    // Both are sorted by term, so one merge pass yields the difference
+    auto prev_iter = previous.begin();
+    auto iter      = counts.begin();
+    while (prev_iter != previous.end() || iter != counts.end())
+    {
+        if (iter == counts.end() ||
+            (prev_iter != previous.end() && prev_iter->term < iter->term))
+        {
+            change_total(prev_iter->term, prev_iter->count, 0);
+            ++prev_iter;
+        }
+        else if (prev_iter == previous.end() || iter->term < prev_iter->term)
+        {
+            change_total(iter->term, 0, iter->count);
+            ++iter;
+        }
+        else
+        {
+            change_total(iter->term, prev_iter->count, iter->count);
+            ++prev_iter;
+            ++iter;
+        }
+    }
+
+    if (counts.empty())
+        regions.erase(region_id);
+    else
+        previous = std::move(counts);
+}
+
+//------------------------------------------------------------------------
+auto FrequencyIndex::remove_region(Id region_id) -> void
+{
+    update_region(region_id, {});
+}
+
+//------------------------------------------------------------------------
+auto FrequencyIndex::clear() -> void
+{
+    regions.clear();
+    totals.clear();
+    ranking.clear();
+}
+
+//------------------------------------------------------------------------
+auto FrequencyIndex::top(size_t k) const -> TermCounts
+{
+    return top_if(k, [](const TermCount&) { return true; });
+}
+
+//------------------------------------------------------------------------
+auto FrequencyIndex::count(TermId term) const -> size_t
+{
+    const auto iter = totals.find(term);
+    return iter != totals.end() ? iter->second : 0;
+}
+
+//------------------------------------------------------------------------
+auto FrequencyIndex::change_total(TermId term, size_t removed, size_t added)
+    -> void
+{
+    if (removed == added)
+        return;
+
+    auto& total = totals[term];
+    if (total > 0)
+        ranking.erase({term, total});
+
+    total = total - removed + added;
+    if (total > 0)
+        ranking.insert({term, total});
+    else
+        totals.erase(term);
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,95 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "region_data.h"
+#include "search_index.h"
+#include "wordify_types.h"
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// FrequencyIndex
+//
+// How often every vocabulary term occurs across all playback regions. Each
+// region contributes the terms of its unclipped words. Updating a region
+// only applies the difference to its previous counts, so only the terms
+// which actually changed are touched. Terms are kept sorted by their count
+// as well, a top-k query costs O(k).
+//------------------------------------------------------------------------
+class FrequencyIndex
+{
+public:
+    //--------------------------------------------------------------------
+    using TermId = Vocabulary::TermId;
+
+    struct TermCount
+    {
+        TermId term  = 0;
+        size_t count = 0;
+    };
+
+    using TermCounts = std::vector<TermCount>;
+
+    /** Counts the terms of the region's unclipped words. Nothing is counted
+     *  if its audio source is not indexed (yet). */
+    static auto count_terms(const RegionWords& words,
+                            const SourceIndex* source_index) -> TermCounts;
+
+    /** Replaces the counts of the region, counts must be sorted by term */
+    auto update_region(Id region_id, TermCounts&& counts) -> void;
+    auto remove_region(Id region_id) -> void;
+    auto clear() -> void;
+
+    /** The k most frequent terms, most frequent first */
+    auto top(size_t k) const -> TermCounts;
+
+    /** Same as above, but only terms passing the predicate count. Costs
+     *  O(k) plus the terms skipped on the way. */
+    template <typename Predicate>
+    auto top_if(size_t k, Predicate&& predicate) const -> TermCounts
+    {
+        TermCounts term_counts;
+        for (auto iter = ranking.begin();
+             iter != ranking.end() && term_counts.size() < k; ++iter)
+        {
+            if (predicate(*iter))
+                term_counts.push_back(*iter);
+        }
+
+        return term_counts;
+    }
+    auto count(TermId term) const -> size_t;
+    auto count_distinct_terms() const -> size_t { return totals.size(); }
+
+    //--------------------------------------------------------------------
+private:
+    struct MoreFrequent
+    {
+        auto operator()(const TermCount& lhs, const TermCount& rhs) const
+            -> bool
+        {
+            if (lhs.count != rhs.count)
+                return lhs.count > rhs.count;
+
+            return lhs.term < rhs.term;
+        }
+    };
+
+    using Regions = std::map<Id, TermCounts>;
+    using Totals  = std::unordered_map<TermId, size_t>;
+    using Ranking = std::set<TermCount, MoreFrequent>;
+
+    auto change_total(TermId term, size_t removed, size_t added) -> void;
+
+    Regions regions;
+    Totals totals;
+    Ranking ranking;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
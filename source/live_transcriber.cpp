@@ -0,0 +1,318 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "live_transcriber.h"
+#include "warn_cpp/suppress_warnings.h"
+#include "whipser_cpp_wrapper.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <string_view>
+BEGIN_SUPPRESS_WARNINGS
+#include "samplerate.h"
+#include "whisper.h"
+END_SUPPRESS_WARNINGS
+
+namespace mam {
+namespace {
+
+//------------------------------------------------------------------------
+using Seconds = LiveTranscriber::Seconds;
+using Samples = std::vector<LiveTranscriber::SampleType>;
+using MetaWord = meta_words::MetaWord;
+
+const double WHISPER_CPP_SAMPLE_RATE   = 16000.;
+constexpr Seconds RING_BUFFER_DURATION = 8.;
+constexpr Seconds STEP                 = 2.;
+constexpr Seconds CONTEXT              = 1.;
+constexpr size_t BLOCK_SIZE            = 4096;
+constexpr auto IDLE_INTERVAL           = std::chrono::milliseconds(20);
+constexpr Seconds WHISPER_TIME_UNIT    = 0.01;
+
+//------------------------------------------------------------------------
+auto to_samples(Seconds seconds) -> size_t
+{
+    return static_cast<size_t>(seconds * WHISPER_CPP_SAMPLE_RATE);
+}
+
+//------------------------------------------------------------------------
+auto to_seconds(size_t samples) -> Seconds
+{
+    return static_cast<Seconds>(samples) / WHISPER_CPP_SAMPLE_RATE;
+}
+
+//------------------------------------------------------------------------
+auto trim(std::string_view str) -> StringType
+{
+    // Leading and trailing whitespace only, whisper starts words with a space
+    const auto is_space = [](char c) {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
+    };
+
+    const auto first = std::find_if_not(str.begin(), str.end(), is_space);
+    const auto last  = std::find_if_not(str.rbegin(), str.rend(), is_space);
+    if (first == str.end())
+        return {};
+
+    return StringType(first, last.base());
+}
+
+//------------------------------------------------------------------------
+auto is_spoken_word(const StringType& word) -> bool
+{
+    // Whisper puts non spoken parts in brackets e.g. [MUSIC] or (laughs)
+    return !word.empty() && word.find_first_of("[(") == StringType::npos;
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// LiveTranscriber
+//------------------------------------------------------------------------
+LiveTranscriber::~LiveTranscriber()
+{
+    stop();
+
+    if (context)
+        whisper_free(context);
+}
+
+//------------------------------------------------------------------------
+auto LiveTranscriber::start(SampleRate sample_rate_) -> bool
+{
+    stop();
+
+    if (sample_rate_ <= 0.)
+        return false;
+
+    sample_rate = sample_rate_;
+    language    = whisper_cpp::get_language();
+    ring_buffer.resize(
+        static_cast<size_t>(sample_rate * RING_BUFFER_DURATION));
+
+    // All buffers are allocated up front, the worker thread only reuses them
+    const auto ratio = WHISPER_CPP_SAMPLE_RATE / sample_rate;
+    input_block.resize(BLOCK_SIZE);
+    resampled_block.resize(
+        static_cast<size_t>(BLOCK_SIZE * std::max(1., ratio)) + 1);
+    window.clear();
+    window.reserve(to_samples(CONTEXT + STEP) + resampled_block.size());
+    window_start    = 0.;
+    committed_until = 0.;
+    {
+        std::lock_guard<std::mutex> lock(words_mutex);
+        words.clear();
+    }
+
+    if (sample_rate != WHISPER_CPP_SAMPLE_RATE)
+    {
+        int error = 0;
+        resampler = src_new(SRC_SINC_FASTEST, 1, &error);
+        if (!resampler)
+            return false;
+    }
+
+    running = true;
+    worker  = std::thread([this]() { run(); });
+
+    return true;
+}
+
+//------------------------------------------------------------------------
+auto LiveTranscriber::stop() -> void
+{
+    // Stopping also cancels a transcription which is still running
+    running = false;
+    if (worker.joinable())
+        worker.join();
+
+    if (resampler)
+    {
+        src_delete(resampler);
+        resampler = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------
+auto LiveTranscriber::push(const SampleType* samples, size_t count) -> void
+{
+    if (!running)
+        return;
+
+    ring_buffer.push(samples, count);
+}
+
+//------------------------------------------------------------------------
+auto LiveTranscriber::copy_words(size_t first, MetaWords& words_) const
+    -> size_t
+{
+    std::lock_guard<std::mutex> lock(words_mutex);
+    if (first >= words.size())
+        return 0;
+
+    words_.insert(words_.end(),
+                  words.begin() + static_cast<std::ptrdiff_t>(first),
+                  words.end());
+
+    return words.size() - first;
+}
+
+//------------------------------------------------------------------------
+auto LiveTranscriber::run() -> void
+{
+    if (!context && !load_model())
+    {
+        running = false;
+        return;
+    }
+
+    // Only the first start has to wait for the model
+    skip_backlog();
+
+    while (running)
+    {
+        const auto count =
+            ring_buffer.pop(input_block.data(), input_block.size());
+        if (count == 0)
+        {
+            std::this_thread::sleep_for(IDLE_INTERVAL);
+            continue;
+        }
+
+        resample(input_block.data(), count);
+        if (window.size() >= to_samples(CONTEXT + STEP))
+        {
+            transcribe_window();
+            skip_backlog();
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+auto LiveTranscriber::load_model() -> bool
+{
+    auto params = whisper_context_default_params();
+    context     = whisper_init_from_file_with_params(
+        whisper_cpp::get_ggml_file_path().data(), params);
+
+    return context != nullptr;
+}
+
+//------------------------------------------------------------------------
+auto LiveTranscriber::skip_backlog() -> void
+{
+    // Up to one STEP of input may have arrived during the transcription
+    const auto max_backlog = static_cast<size_t>(sample_rate * STEP);
+    const auto backlog     = ring_buffer.size();
+    if (backlog <= max_backlog)
+        return;
+
+    const auto skipped = ring_buffer.skip(backlog);
+
+    // The input is not contiguous anymore, so the context is useless and the
+    // next window starts after the gap
+    const auto window_end = window_start + to_seconds(window.size());
+    window.clear();
+    window_start    = window_end + static_cast<Seconds>(skipped) / sample_rate;
+    committed_until = window_start;
+
+    if (resampler)
+        src_reset(resampler);
+}
+
+//------------------------------------------------------------------------
+auto LiveTranscriber::resample(const SampleType* samples, size_t count) -> void
+{
+    if (!resampler)
+    {
+        window.insert(window.end(), samples, samples + count);
+        return;
+    }
+
+    SRC_DATA data{};
+    data.data_in       = samples;
+    data.input_frames  = static_cast<long>(count);
+    data.data_out      = resampled_block.data();
+    data.output_frames = static_cast<long>(resampled_block.size());
+    data.src_ratio     = WHISPER_CPP_SAMPLE_RATE / sample_rate;
+    data.end_of_input  = 0;
+
+    while (data.input_frames > 0)
+    {
+        if (src_process(resampler, &data) != 0)
+            return;
+
+        window.insert(window.end(), resampled_block.begin(),
+                      resampled_block.begin() + data.output_frames_gen);
+
+        if (data.input_frames_used == 0 && data.output_frames_gen == 0)
+            break;
+
+        data.data_in += data.input_frames_used;
+        data.input_frames -= data.input_frames_used;
+    }
+}
+
+//------------------------------------------------------------------------
+auto LiveTranscriber::transcribe_window() -> void
+{
+    const auto window_end = window_start + to_seconds(window.size());
+    const auto commit_end = window_end - CONTEXT;
+
+    auto params = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
+    params.print_progress   = false;
+    params.print_realtime   = false;
+    params.print_timestamps = false;
+    params.print_special    = false;
+    params.no_context       = true;
+    params.token_timestamps = true;
+    params.split_on_word    = true;
+    params.max_len          = 1; // one word per segment
+    params.language         = language.data();
+    params.abort_callback   = [](void* user_data) {
+        // Stopping also cancels a transcription which is still running
+        return !static_cast<LiveTranscriber*>(user_data)->running.load();
+    };
+    params.abort_callback_user_data = this;
+
+    MetaWords new_words;
+    if (whisper_full(context, params, window.data(),
+                     static_cast<int>(window.size())) == 0)
+    {
+        const auto count = whisper_full_n_segments(context);
+        for (int i = 0; i < count; i++)
+        {
+            // Whisper delivers centiseconds relative to the window
+            const auto t0 = static_cast<Seconds>(
+                whisper_full_get_segment_t0(context, i));
+            const auto t1 = static_cast<Seconds>(
+                whisper_full_get_segment_t1(context, i));
+
+            MetaWord word;
+            word.value    = trim(whisper_full_get_segment_text(context, i));
+            word.begin    = window_start + t0 * WHISPER_TIME_UNIT;
+            word.duration = (t1 - t0) * WHISPER_TIME_UNIT;
+            if (word.begin < committed_until || word.begin >= commit_end)
+                continue;
+
+            if (is_spoken_word(word.value))
+                new_words.push_back(word);
+        }
+    }
+
+    if (!new_words.empty())
+    {
+        std::lock_guard<std::mutex> lock(words_mutex);
+        words.insert(words.end(), new_words.begin(), new_words.end());
+    }
+
+    // The end of the window becomes the context of the next one
+    const auto keep = std::min(window.size(), to_samples(CONTEXT));
+    window.erase(window.begin(),
+                 window.end() - static_cast<std::ptrdiff_t>(keep));
+    window_start    = window_end - to_seconds(keep);
+    committed_until = commit_end;
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,89 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "mam/meta_words/meta_word.h"
+#include "spsc_ring_buffer.h"
+#include "wordify_types.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct SRC_STATE_tag;
+struct whisper_context;
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// LiveTranscriber
+//
+// Transcribes the plug-in's audio input while it is running. The audio
+// thread only pushes samples into a lock free ring buffer. A worker thread
+// drains it, resamples to 16kHz and transcribes a rolling window every
+// STEP seconds. The whisper.cpp model is loaded in-process by the first
+// start and stays loaded until the transcriber is destroyed, so a window
+// costs the inference only. Each window starts with the last CONTEXT seconds of the
+// previous one, words inside this overlap are only taken from the window in
+// which they are not at its end anymore.
+//
+// Whenever a transcription took longer than a STEP, the input which piled
+// up meanwhile is dropped. The transcript gets a gap but never lags behind
+// the input more and more.
+//------------------------------------------------------------------------
+class LiveTranscriber
+{
+public:
+    //--------------------------------------------------------------------
+    using SampleType = float;
+    using SampleRate = double;
+    using Seconds    = double;
+    using MetaWords  = meta_words::MetaWords;
+
+    LiveTranscriber() = default;
+    ~LiveTranscriber();
+
+    /** Not thread safe, call while the audio thread is not processing */
+    auto start(SampleRate sample_rate) -> bool;
+    auto stop() -> void;
+    auto is_running() const -> bool { return running; }
+
+    /** Audio thread only. Wait free, samples which do not fit into the ring
+     *  buffer are dropped. */
+    auto push(const SampleType* samples, size_t count) -> void;
+
+    /** Appends all transcribed words starting at index 'first' and returns
+     *  their count. Times are in seconds since start. */
+    auto copy_words(size_t first, MetaWords& words) const -> size_t;
+
+    //--------------------------------------------------------------------
+private:
+    using Samples = std::vector<SampleType>;
+
+    auto run() -> void;
+    auto load_model() -> bool;
+    auto resample(const SampleType* samples, size_t count) -> void;
+    auto transcribe_window() -> void;
+    auto skip_backlog() -> void;
+
+    SpscRingBuffer<SampleType> ring_buffer;
+    std::atomic<bool> running{false};
+    std::thread worker;
+
+    // Worker thread only
+    whisper_context* context = nullptr;
+    SRC_STATE_tag* resampler = nullptr;
+    SampleRate sample_rate   = 0.;
+    Samples input_block;
+    Samples resampled_block;
+    Samples window;
+    Seconds window_start    = 0.;
+    Seconds committed_until = 0.;
+    StringType language;
+
+    mutable std::mutex words_mutex;
+    MetaWords words;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
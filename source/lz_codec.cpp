@@ -0,0 +1,225 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "lz_codec.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace mam::lz_codec {
+namespace {
+
+//------------------------------------------------------------------------
+constexpr size_t MIN_MATCH   = 4;
+constexpr size_t MAX_OFFSET  = 0xffff;
+constexpr size_t MAX_NIBBLE  = 0x0f;
+constexpr size_t MAX_BYTE    = 0xff;
+constexpr uint32_t HASH_BITS = 14;
+
+//------------------------------------------------------------------------
+auto read_u32(const char* data) -> uint32_t
+{
+    uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+//------------------------------------------------------------------------
+auto hash(uint32_t value) -> uint32_t
+{
+    // Knuth's multiplicative hash, the upper bits are mixed best
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+//------------------------------------------------------------------------
+auto write_length(size_t length, StringType& out) -> void
+{
+    for (; length >= MAX_BYTE; length -= MAX_BYTE)
+        out.push_back(static_cast<char>(MAX_BYTE));
+
+    out.push_back(static_cast<char>(length));
+}
+
+//------------------------------------------------------------------------
+auto write_literals(StringView literals, size_t match_nibble, StringType& out)
+    -> void
+{
+    const auto literal_nibble = std::min(literals.size(), MAX_NIBBLE);
+    out.push_back(static_cast<char>(literal_nibble << 4 | match_nibble));
+    if (literal_nibble == MAX_NIBBLE)
+        write_length(literals.size() - MAX_NIBBLE, out);
+
+    out.append(literals);
+}
+
+//------------------------------------------------------------------------
+auto write_sequence(StringView literals,
+                    size_t offset,
+                    size_t length,
+                    StringType& out) -> void
+{
+    const auto extra_length = length - MIN_MATCH;
+    const auto match_nibble = std::min(extra_length, MAX_NIBBLE);
+    write_literals(literals, match_nibble, out);
+
+    out.push_back(static_cast<char>(offset & MAX_BYTE));
+    out.push_back(static_cast<char>(offset >> 8));
+    if (match_nibble == MAX_NIBBLE)
+        write_length(extra_length - MAX_NIBBLE, out);
+}
+
+//------------------------------------------------------------------------
+// Every read fails instead of reading past the end
+class StreamReader
+{
+public:
+    //--------------------------------------------------------------------
+    explicit StreamReader(StringView in)
+    : in(in)
+    {
+    }
+
+    auto at_end() const -> bool { return pos == in.size(); }
+
+    auto byte(size_t& value) -> bool
+    {
+        if (at_end())
+            return false;
+
+        value = static_cast<unsigned char>(in[pos++]);
+        return true;
+    }
+
+    auto length(size_t nibble, size_t& value) -> bool
+    {
+        value = nibble;
+        if (nibble < MAX_NIBBLE)
+            return true;
+
+        size_t next = MAX_BYTE;
+        while (next == MAX_BYTE)
+        {
+            if (!byte(next))
+                return false;
+
+            value += next;
+        }
+
+        return true;
+    }
+
+    auto bytes(size_t count, StringView& value) -> bool
+    {
+        if (count > in.size() - pos)
+            return false;
+
+        value = in.substr(pos, count);
+        pos += count;
+        return true;
+    }
+
+    //--------------------------------------------------------------------
+private:
+    StringView in;
+    size_t pos = 0;
+};
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+auto compress(StringView in, StringType& out) -> void
+{
+    // Last position + 1 of every hashed 4 byte sequence, 0 is none
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+
+    const auto* data = in.data();
+    size_t anchor    = 0;
+    size_t pos       = 0;
+    while (pos + MIN_MATCH <= in.size())
+    {
+        const auto sequence  = read_u32(data + pos);
+        auto& entry          = table[hash(sequence)];
+        const auto candidate = static_cast<size_t>(entry);
+        entry                = static_cast<uint32_t>(pos + 1);
+
+        if (candidate == 0 || pos + 1 - candidate > MAX_OFFSET ||
+            read_u32(data + candidate - 1) != sequence)
+        {
+            pos++;
+            continue;
+        }
+
+        const auto match = candidate - 1;
+        auto length      = MIN_MATCH;
+        while (pos + length < in.size() &&
+               data[match + length] == data[pos + length])
+            length++;
+
+        write_sequence(in.substr(anchor, pos - anchor), pos - match, length,
+                       out);
+        pos += length;
+        anchor = pos;
+    }
+
+    write_literals(in.substr(anchor), 0, out);
+}
+
+//------------------------------------------------------------------------
+auto decompress(StringView in, size_t size, StringType& out) -> bool
+{
+    const auto begin = out.size();
+    out.resize(begin + size);
+    auto* data = out.data() + begin;
+
+    // A stream always ends with a sequence of literals only, even an empty
+    // one, so a stream truncated after a match is rejected
+    StreamReader reader(in);
+    size_t pos = 0;
+    while (true)
+    {
+        size_t token          = 0;
+        size_t literal_length = 0;
+        StringView literals;
+        if (!reader.byte(token) || !reader.length(token >> 4, literal_length) ||
+            literal_length > size - pos ||
+            !reader.bytes(literal_length, literals))
+            return false;
+
+        std::memcpy(data + pos, literals.data(), literals.size());
+        pos += literals.size();
+
+        // The last sequence has no match
+        if (reader.at_end())
+            break;
+
+        size_t low    = 0;
+        size_t high   = 0;
+        size_t length = 0;
+        if (!reader.byte(low) || !reader.byte(high) ||
+            !reader.length(token & MAX_NIBBLE, length))
+            return false;
+
+        const auto offset = low | high << 8;
+        length += MIN_MATCH;
+        if (offset == 0 || offset > pos || length > size - pos)
+            return false;
+
+        // Matches may overlap the bytes they produce, e.g. runs
+        const auto* from = data + pos - offset;
+        if (offset >= length)
+            std::memcpy(data + pos, from, length);
+        else
+        {
+            for (size_t i = 0; i < length; i++)
+                data[pos + i] = from[i];
+        }
+
+        pos += length;
+    }
+
+    return pos == size;
+}
+
+//------------------------------------------------------------------------
+} // namespace mam::lz_codec
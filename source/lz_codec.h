@@ -0,0 +1,29 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "wordify_types.h"
+#include <string_view>
+
+namespace mam::lz_codec {
+
+//------------------------------------------------------------------------
+// lz_codec
+//
+// Small and fast LZ77 byte codec, laid out like the LZ4 block format. Each
+// sequence is a token (literal length and match length in one nibble each,
+// longer ones continue in bytes of 255), the literals and the match as a
+// 16 bit offset back into the output. The stream ends with literals only.
+// The uncompressed size is not part of the stream, callers keep it.
+//------------------------------------------------------------------------
+using StringView = std::string_view;
+
+/** Appends the compressed bytes of in to out */
+auto compress(StringView in, StringType& out) -> void;
+
+/** Appends exactly size decompressed bytes to out. False if in is corrupt
+ *  or does not decompress to size bytes, out is undefined then. */
+auto decompress(StringView in, size_t size, StringType& out) -> bool;
+
+//------------------------------------------------------------------------
+} // namespace mam::lz_codec
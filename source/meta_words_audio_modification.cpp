@@ -3,6 +3,7 @@
 //------------------------------------------------------------------------
 
 #include "meta_words_audio_modification.h"
+#include "meta_words_audio_source.h"
 #include "ARA_Library/PlugIn/ARAPlug.h"
 
 namespace mam::meta_words {
@@ -15,5 +16,15 @@ AudioModification::AudioModification(
       audioSource, hostRef, optionalModificationToClone)
 {
 }
+
+//------------------------------------------------------------------------
+auto AudioModification::get_word_store() const -> WordStorePtr
+{
+    if (const auto* source = getAudioSource<AudioSource>())
+        return source->get_word_store();
+
+    return nullptr;
+}
+
 //------------------------------------------------------------------------
 } // namespace mam::meta_words
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include "mam/meta_words/meta_word.h"
 #include "warn_cpp/suppress_warnings.h"
+#include "word_store.h"
 BEGIN_SUPPRESS_WARNINGS
 #include "ARA_Library/PlugIn/ARAPlug.h"
 END_SUPPRESS_WARNINGS
@@ -21,6 +22,10 @@ public:
                       ARA::ARAAudioModificationHostRef hostRef,
                       const ARA::PlugIn::AudioModification*
                           optionalModificationToClone) noexcept;
+
+    /** All audio modifications share the word store of their audio source */
+    auto get_word_store() const -> WordStorePtr;
+
     //--------------------------------------------------------------------
 private:
 };
@@ -3,15 +3,18 @@
 #include "meta_words_audio_source.h"
 #include "little_helpers.h"
 #include "mam/meta_words/runner.h"
+#include "meta_words_serde.h"
 #include "task_manager.h"
 #include "warn_cpp/suppress_warnings.h"
 #include "wordify_defines.h"
 #include "wordify_types.h"
 #include <cassert>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <filesystem>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <thread>
 BEGIN_SUPPRESS_WARNINGS
@@ -259,6 +262,18 @@ auto write_audio_file(AudioSource& audio_source) -> const PathType
     return path;
 }
 
+//------------------------------------------------------------------------
+auto create_word_store(const serde::EncodedWords& encoded_words)
+    -> WordStorePtr
+{
+    // A corrupt block leaves the audio source without words
+    MetaWords meta_words;
+    if (!serde::decode(encoded_words, meta_words))
+        meta_words.clear();
+
+    return WordStore::create(std::move(meta_words));
+}
+
 //------------------------------------------------------------------------
 } // namespace
 
@@ -308,10 +323,11 @@ void AudioSource::updateRenderSampleCache()
             if (expected_result.was_canceled)
                 return;
 
+            MetaWords meta_words;
             if (expected_result.data.has_value())
                 meta_words = expected_result.data.value();
 
-            end_analysis();
+            end_analysis(std::move(meta_words));
         });
 
     begin_analysis();
@@ -344,10 +360,13 @@ void AudioSource::perform_analysis()
 }
 
 //------------------------------------------------------------------------
-void AudioSource::end_analysis()
+void AudioSource::end_analysis(MetaWords&& meta_words)
 {
     meta_words = transform_to_seconds(meta_words);
     meta_words = prepare_meta_words(meta_words);
+    discard_encoded_words();
+    word_store = WordStore::create(std::move(meta_words));
+    generation++;
 
     const AnalyseProgressData& data = {
         /*.id*/ get_id(),
@@ -375,19 +394,92 @@ void AudioSource::destroyRenderSampleCache()
 }
 
 //------------------------------------------------------------------------
-auto AudioSource::get_meta_words() const -> const MetaWords&
+auto AudioSource::set_meta_words(MetaWords meta_words) -> void
 {
-    return meta_words;
+    if (task_id.has_value())
+        task_managing::cancel_task(task_id.value());
+
+    discard_encoded_words();
+    meta_words = prepare_meta_words(meta_words);
+    word_store = WordStore::create(std::move(meta_words));
+    generation++;
 }
 
 //------------------------------------------------------------------------
-auto AudioSource::set_meta_words(const MetaWords& meta_words_) -> void
+auto AudioSource::set_encoded_words(EncodedWordsPtr encoded_words_) -> void
 {
     if (task_id.has_value())
         task_managing::cancel_task(task_id.value());
 
-    meta_words = meta_words_;
-    prepare_meta_words(meta_words);
+    discard_encoded_words();
+    encoded_words = std::move(encoded_words_);
+    word_store    = nullptr;
+    generation++;
+}
+
+//------------------------------------------------------------------------
+auto AudioSource::prefetch_words(ThreadPool& pool) -> bool
+{
+    if (!encoded_words || prefetched_words.valid())
+        return false;
+
+    // Whoever claims the encoded words first decodes them, the pool or
+    // get_word_store. So a prefetch still waiting in the queue never
+    // holds up an access.
+    auto promise     = std::make_shared<std::promise<WordStorePtr>>();
+    prefetched_words = promise->get_future();
+    prefetch_claim   = std::make_shared<std::atomic<bool>>(false);
+
+    pool.post([promise, claim = prefetch_claim, encoded = encoded_words]() {
+        if (claim->exchange(true))
+            return;
+
+        try
+        {
+            promise->set_value(create_word_store(*encoded));
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return true;
+}
+
+//------------------------------------------------------------------------
+auto AudioSource::is_prefetching() const -> bool
+{
+    return prefetched_words.valid() &&
+           prefetched_words.wait_for(std::chrono::seconds(0)) !=
+               std::future_status::ready;
+}
+
+//------------------------------------------------------------------------
+auto AudioSource::get_word_store() const -> const WordStorePtr&
+{
+    // Decoded on first access, unless the prefetch did it already
+    if (encoded_words)
+    {
+        const bool is_claimed =
+            prefetch_claim && prefetch_claim->exchange(true);
+        word_store = is_claimed ? prefetched_words.get()
+                                : create_word_store(*encoded_words);
+        discard_encoded_words();
+    }
+
+    return word_store;
+}
+
+//------------------------------------------------------------------------
+auto AudioSource::discard_encoded_words() const -> void
+{
+    // A queued prefetch is skipped, a running one finishes on its own
+    if (prefetch_claim)
+        prefetch_claim->store(true);
+
+    prefetched_words = {};
+    prefetch_claim   = nullptr;
+    encoded_words    = nullptr;
 }
 
 //------------------------------------------------------------------------
@@ -4,8 +4,12 @@
 
 #include "audio_buffer_management.h"
 #include "mam/meta_words/meta_word.h"
+#include "meta_words_serde.h"
+#include "thread_pool.h"
 #include "warn_cpp/suppress_warnings.h"
+#include "word_store.h"
 #include "wordify_types.h"
+#include <atomic>
 #include <future>
 #include <optional>
 BEGIN_SUPPRESS_WARNINGS
@@ -44,6 +48,8 @@ public:
     using MetaWords           = mam::meta_words::MetaWords;
     using FnChanged           = std::function<void(AudioSource*)>;
     using FuncAnalyseProgress = std::function<void(const AnalyseProgressData&)>;
+    using Generation          = size_t;
+    using EncodedWordsPtr     = serde::EncodedWordsPtr;
 
     AudioSource(ARA::PlugIn::Document* document,
                 ARA::ARAAudioSourceHostRef hostRef,
@@ -55,22 +61,43 @@ public:
     auto getRenderSampleCache(ARA::ARAChannelCount channel) const -> const
         float*;
     auto get_audio_buffers() -> MultiChannelBufferType&;
-    auto get_meta_words() const -> const MetaWords&;
-    auto set_meta_words(const MetaWords& meta_words) -> void;
+    auto set_meta_words(MetaWords meta_words) -> void;
+
+    /** Words restored from an archive, decoded on first access only */
+    auto set_encoded_words(EncodedWordsPtr encoded_words) -> void;
+    auto has_encoded_words() const -> bool { return encoded_words != nullptr; }
+
+    /** Queues decoding the encoded words on the pool, so the first access
+     *  does not have to. False if there is nothing to start. */
+    auto prefetch_words(ThreadPool& pool) -> bool;
+    auto is_prefetching() const -> bool;
+
+    auto get_word_store() const -> const WordStorePtr&;
     auto get_id() const -> Id { return id; }
 
+    /** Changes whenever the words change, e.g. to tell if something
+     *  derived from them is still up to date */
+    auto get_generation() const -> Generation { return generation; }
+
     FuncAnalyseProgress analyse_progress_func;
 
     //--------------------------------------------------------------------
 protected:
     void begin_analysis();
     void perform_analysis();
-    void end_analysis();
+    void end_analysis(MetaWords&& meta_words);
+    auto discard_encoded_words() const -> void;
 
     Id id{0};
     OptionalId task_id;
     MultiChannelBufferType audio_buffers;
-    MetaWords meta_words;
+    Generation generation = 0;
+
+    // Decoding on access changes these, the words stay the same
+    mutable WordStorePtr word_store;
+    mutable EncodedWordsPtr encoded_words;
+    mutable std::future<WordStorePtr> prefetched_words;
+    mutable std::shared_ptr<std::atomic<bool>> prefetch_claim;
 };
 
 //------------------------------------------------------------------------
@@ -13,11 +13,5 @@ EditorRenderer::EditorRenderer(
 {
 }
 
-//------------------------------------------------------------------------
-auto EditorRenderer::update_project_time(Seconds time_) -> void
-{
-    this->time = time_;
-}
-
 //------------------------------------------------------------------------
 } // namespace mam::meta_words
\ No newline at end of file
@@ -16,15 +16,8 @@ class EditorRenderer : public ARA::PlugIn::EditorRenderer
 {
 public:
     //--------------------------------------------------------------------
-    using Seconds = double;
-
     explicit EditorRenderer(
         ARA::PlugIn::DocumentController* document_controller) noexcept;
-
-    auto update_project_time(Seconds time) -> void;
-    //--------------------------------------------------------------------
-private:
-    Seconds time = 0.;
 };
 
 //------------------------------------------------------------------------
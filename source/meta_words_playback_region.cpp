@@ -1,31 +1,15 @@
 // Copyright (c) 2023-present, WordifyOrg.
 
 #include "meta_words_playback_region.h"
+#include "meta_words_audio_modification.h"
 #include "meta_words_audio_source.h"
 #include "warn_cpp/suppress_warnings.h"
-#include <array>
 BEGIN_SUPPRESS_WARNINGS
 #include "ARA_Library/PlugIn/ARAPlug.h"
 END_SUPPRESS_WARNINGS
 
 namespace mam::meta_words {
 
-//------------------------------------------------------------------------
-using Word                                      = StringType;
-using PunctuationMarks                          = std::array<Word, 15>;
-static const PunctuationMarks PUNCTUATION_MARKS = {".", "?", "!", ",",  ";",
-                                                   "-", "(", ")", "[",  "]",
-                                                   "{", "}", "'", "\"", "..."};
-static auto is_puntuation_mark(const Word& word) -> bool
-{
-    for (auto& el : PUNCTUATION_MARKS)
-    {
-        if (el == word)
-            return true;
-    }
-    return false;
-}
-
 //------------------------------------------------------------------------
 using Seconds = const RegionData::Seconds;
 
@@ -36,59 +20,18 @@ static auto calculate_project_offset(const PlaybackRegion& region) -> Seconds
 }
 
 //------------------------------------------------------------------------
-static auto is_in_playback_region(const PlaybackRegion& region,
-                                  const meta_words::MetaWord& word) -> bool
-{
-    const auto start_time = region.getStartInAudioModificationTime();
-    const auto end_time   = (region.getStartInAudioModificationTime() +
-                           region.getDurationInAudioModificationTime());
-
-    const auto word_end = word.begin + word.duration;
-
-    const bool is_in = (word.begin >= start_time && word.begin < end_time) ||
-                       (word_end >= start_time && word_end < end_time);
-
-    return is_in;
-}
-
-//------------------------------------------------------------------------
-static auto
-mark_clipped_words(RegionWordDataset& words,
-                   const PlaybackRegion& region) -> RegionWordDataset
-{
-    for (auto& word_data : words)
-    {
-        word_data.is_clipped_by_region =
-            !is_in_playback_region(region, word_data.word);
-    }
-
-    return words;
-}
-
-//------------------------------------------------------------------------
-static auto
-collect_meta_words(const PlaybackRegion& region) -> const RegionWordDataset
+static auto collect_region_words(const PlaybackRegion& region) -> RegionWords
 {
-    RegionWordDataset word_dataset;
+    const auto* modification =
+        region.getAudioModification<AudioModification>();
+    if (!modification)
+        return {};
 
-    if (const auto* modification = region.getAudioModification())
-    {
-        if (const auto* source = modification->getAudioSource<AudioSource>())
-        {
-            const auto meta_words = source->get_meta_words();
-            for (const auto& meta_word : meta_words)
-            {
-                RegionWordData word_data;
-                word_data.word                 = meta_word;
-                word_data.is_clipped_by_region = true;
-                word_data.is_punctuation_mark =
-                    is_puntuation_mark(meta_word.value);
-                word_dataset.push_back(word_data);
-            }
-        }
-    }
+    const auto start_time = region.getStartInAudioModificationTime();
+    const auto end_time =
+        start_time + region.getDurationInAudioModificationTime();
 
-    return word_dataset;
+    return {modification->get_word_store(), start_time, end_time};
 }
 
 //------------------------------------------------------------------------
@@ -117,11 +60,9 @@ const RegionData PlaybackRegion::get_region_data() const
 {
     RegionData data;
 
-    data.words = collect_meta_words(*this);
     // Since we calculate everything in seconds, we dont need modify timestamps
     // to the sample rate
-    // data.words = modify_time_stamps(data.words, *this, playback_sample_rate);
-    data.words              = mark_clipped_words(data.words, *this);
+    data.words              = get_region_words();
     data.project_offset     = calculate_project_offset(*this);
     data.project_time_start = getStartInPlaybackTime();
     data.duration           = getDurationInPlaybackTime();
@@ -135,6 +76,18 @@ const RegionData PlaybackRegion::get_region_data() const
     return data;
 }
 
+//------------------------------------------------------------------------
+auto PlaybackRegion::get_region_words() const -> RegionWords
+{
+    return collect_region_words(*this);
+}
+
+//------------------------------------------------------------------------
+auto PlaybackRegion::get_audio_source_id() const -> Id
+{
+    return getAudioModification()->getAudioSource<AudioSource>()->get_id();
+}
+
 //------------------------------------------------------------------------
 auto PlaybackRegion::get_audio_buffer() const -> const AudioBufferSpanData
 {
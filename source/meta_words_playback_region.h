@@ -36,8 +36,10 @@ public:
                             ARA::ARAPlaybackRegionHostRef hostRef) noexcept;
 
     auto get_region_data() const -> const RegionData;
+    auto get_region_words() const -> RegionWords;
     auto get_audio_buffer() const -> const AudioBufferSpanData;
     auto get_id() const -> Id { return id; }
+    auto get_audio_source_id() const -> Id;
     auto get_effective_color() const -> Color;
 
     //--------------------------------------------------------------------
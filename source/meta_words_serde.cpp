@@ -3,12 +3,19 @@
 //------------------------------------------------------------------------
 
 #include "meta_words_serde.h"
+#include "lz_codec.h"
 #include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
 
 namespace mam::meta_words {
 
 //------------------------------------------------------------------------
 using JsonString = StringType;
+using StringView = std::string_view;
 using json       = nlohmann::json;
 void to_json(json& j, const MetaWord& m)
 {
@@ -16,63 +23,898 @@ void to_json(json& j, const MetaWord& m)
 }
 
 //------------------------------------------------------------------------
-void from_json(const json& j, MetaWord& m)
+
+namespace serde {
+
+//------------------------------------------------------------------------
+void to_json(json& j, const AudioSource& mws)
 {
-    j.at("word").get_to(m.value);
-    j.at("begin").get_to(m.begin);
-    j.at("duration").get_to(m.duration);
+    j = json{{"persistent_id", mws.persistent_id}, {"words", mws.words}};
 }
 
 //------------------------------------------------------------------------
+void to_json(json& j, const Archive& archive)
+{
+    j = json{{"archive_version", archive.version},
+             {"audio_sources", archive.audio_sources}};
+}
 
-namespace serde {
+//------------------------------------------------------------------------
+namespace {
 
 //------------------------------------------------------------------------
-void to_json(json& j, const AudioSource& mws)
+// Reads the archive in chunks of ARCHIVE_CHUNK_SIZE bytes
+//------------------------------------------------------------------------
+class ChunkReader
 {
-    j = json{{"persistent_id", mws.persistent_id}, {"words", mws.words}};
+public:
+    //--------------------------------------------------------------------
+    ChunkReader(size_t archive_size, const ReadFunc& read_func)
+    : archive_size(archive_size)
+    , read_func(read_func)
+    {
+    }
+
+    auto next(unsigned char& byte) -> bool
+    {
+        if (pos == chunk.size() && !fill())
+            return false;
+
+        byte = static_cast<unsigned char>(chunk[pos++]);
+        return true;
+    }
+
+    auto read(size_t size, char* data) -> bool
+    {
+        while (size > 0)
+        {
+            if (pos == chunk.size() && !fill())
+                return false;
+
+            const auto count = std::min(size, chunk.size() - pos);
+            std::memcpy(data, chunk.data() + pos, count);
+            pos += count;
+            data += count;
+            size -= count;
+        }
+
+        return true;
+    }
+
+    /** Up to size bytes from the current position, without consuming them */
+    auto peek(size_t size) -> StringView
+    {
+        if (pos == chunk.size())
+            fill();
+
+        return StringView(chunk).substr(pos, size);
+    }
+
+    auto seek(size_t position) -> bool
+    {
+        if (position > archive_size)
+            return false;
+
+        if (position >= chunk_position &&
+            position <= chunk_position + chunk.size())
+        {
+            pos = position - chunk_position;
+            return true;
+        }
+
+        chunk_position = position;
+        chunk.clear();
+        pos = 0;
+        return true;
+    }
+
+    auto position() const -> size_t { return chunk_position + pos; }
+    auto remaining() const -> size_t { return archive_size - position(); }
+
+    //--------------------------------------------------------------------
+private:
+    auto fill() -> bool
+    {
+        chunk_position += chunk.size();
+        pos = 0;
+
+        const auto size =
+            std::min(ARCHIVE_CHUNK_SIZE, archive_size - chunk_position);
+        chunk.resize(size);
+
+        return size > 0 && read_func(chunk_position, size, chunk.data());
+    }
+
+    size_t archive_size = 0;
+    const ReadFunc& read_func;
+    StringType chunk;
+    size_t chunk_position = 0; // Archive position of the chunk
+    size_t pos            = 0; // Position within the chunk
+};
+
+//------------------------------------------------------------------------
+// Writes the archive in chunks of ARCHIVE_CHUNK_SIZE bytes
+//------------------------------------------------------------------------
+class ChunkWriter
+{
+public:
+    //--------------------------------------------------------------------
+    explicit ChunkWriter(const WriteFunc& write_func)
+    : write_func(write_func)
+    {
+    }
+
+    auto append(StringView bytes) -> bool
+    {
+        while (!bytes.empty())
+        {
+            const auto count =
+                std::min(bytes.size(), ARCHIVE_CHUNK_SIZE - chunk.size());
+            chunk.append(bytes.substr(0, count));
+            bytes.remove_prefix(count);
+
+            if (chunk.size() == ARCHIVE_CHUNK_SIZE && !flush())
+                return false;
+        }
+
+        return true;
+    }
+
+    auto flush() -> bool
+    {
+        if (chunk.empty())
+            return true;
+
+        if (!write_func(position, chunk.size(), chunk.data()))
+            return false;
+
+        position += chunk.size();
+        chunk.clear();
+        return true;
+    }
+
+    //--------------------------------------------------------------------
+private:
+    const WriteFunc& write_func;
+    StringType chunk;
+    size_t position = 0;
+};
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// Binary archive, version 2. Integers are little endian, varints LEB128 and
+// signed varints zigzag encoded. Timestamps are microseconds.
+//
+// Header   "WRDY", u32 version, u32 flags, u32 count of audio sources.
+//          Flags: COMPRESSED_BLOCKS
+// Index    per audio source: persistent id (varint length and bytes),
+//          varint count of words, varint offset and size of its block.
+//          Offsets are relative to the end of the index.
+// Blocks   per audio source: the string table (varint count, then varint
+//          length and bytes of each distinct word), followed by the
+//          columns: string table index of each word, begin deltas (signed)
+//          and durations (signed), one varint per word each. Compressed
+//          blocks are the varint size of that followed by its lz_codec
+//          stream.
+//------------------------------------------------------------------------
+namespace binary {
+
+using Ticks = int64_t;
+
+constexpr char MAGIC[]              = {'W', 'R', 'D', 'Y'};
+constexpr size_t HEADER_SIZE        = 16;
+constexpr double TICKS_PER_SECOND   = 1000000.;
+constexpr size_t MIN_BYTES_PER_WORD = 3;
+constexpr size_t MAX_VARINT_BYTES   = 10;
+
+// An lz_codec byte expands to 255 bytes at most
+constexpr size_t MAX_COMPRESSION_RATIO = 255;
+
+// Flags
+constexpr uint32_t COMPRESSED_BLOCKS = 1 << 0;
+constexpr uint32_t KNOWN_FLAGS       = COMPRESSED_BLOCKS;
+
+//------------------------------------------------------------------------
+auto to_ticks(double seconds) -> Ticks
+{
+    return static_cast<Ticks>(std::llround(seconds * TICKS_PER_SECOND));
 }
 
 //------------------------------------------------------------------------
-void from_json(const json& j, AudioSource& mws)
+auto to_seconds(Ticks ticks) -> double
 {
-    j.at("persistent_id").get_to(mws.persistent_id);
-    j.at("words").get_to(mws.words);
+    return static_cast<double>(ticks) / TICKS_PER_SECOND;
 }
 
 //------------------------------------------------------------------------
-void to_json(json& j, const Archive& archive)
+class Writer
 {
-    j = json{{"archive_version", archive.version},
-             {"audio_sources", archive.audio_sources}};
+public:
+    //--------------------------------------------------------------------
+    explicit Writer(StringType& out)
+    : out(out)
+    {
+    }
+
+    auto u32(uint32_t value) -> void
+    {
+        for (int i = 0; i < 4; i++)
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+
+    auto varint(uint64_t value) -> void
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+
+        out.push_back(static_cast<char>(value));
+    }
+
+    auto signed_varint(int64_t value) -> void
+    {
+        varint((static_cast<uint64_t>(value) << 1) ^
+               static_cast<uint64_t>(value >> 63));
+    }
+
+    auto string(StringView value) -> void
+    {
+        varint(value.size());
+        out.append(value);
+    }
+
+    auto bytes(StringView value) -> void { out.append(value); }
+
+    //--------------------------------------------------------------------
+private:
+    StringType& out;
+};
+
+//------------------------------------------------------------------------
+template <typename ByteSource>
+auto read_u32(ByteSource& source, uint32_t& value) -> bool
+{
+    value              = 0;
+    unsigned char byte = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        if (!source.next(byte))
+            return false;
+
+        value |= uint32_t(byte) << (8 * i);
+    }
+
+    return true;
 }
 
 //------------------------------------------------------------------------
-void from_json(const json& j, Archive& archive)
+template <typename ByteSource>
+auto read_varint(ByteSource& source, uint64_t& value) -> bool
 {
-    j.at("archive_version").get_to(archive.version);
-    j.at("audio_sources").get_to(archive.audio_sources);
+    value              = 0;
+    unsigned char byte = 0;
+    for (size_t i = 0; i < MAX_VARINT_BYTES && source.next(byte); i++)
+    {
+        value |= uint64_t(byte & 0x7f) << (7 * i);
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
 }
 
 //------------------------------------------------------------------------
-auto serialize(const Archive& archive, JsonString& s) -> bool
+template <typename ByteSource>
+auto read_signed_varint(ByteSource& source, int64_t& value) -> bool
 {
-    json j = archive;
-    s      = j.dump();
+    uint64_t zigzag = 0;
+    if (!read_varint(source, zigzag))
+        return false;
 
+    value = static_cast<int64_t>(zigzag >> 1) ^
+            -static_cast<int64_t>(zigzag & 1);
     return true;
 }
+
+//------------------------------------------------------------------------
+// Block in memory, every read fails instead of reading past its end
+class Reader
+{
+public:
+    //--------------------------------------------------------------------
+    explicit Reader(StringView in)
+    : in(in)
+    {
+    }
+
+    auto next(unsigned char& byte) -> bool
+    {
+        if (pos == in.size())
+            return false;
+
+        byte = static_cast<unsigned char>(in[pos++]);
+        return true;
+    }
+
+    auto string(StringView& value) -> bool
+    {
+        uint64_t size = 0;
+        if (!read_varint(*this, size) || size > in.size() - pos)
+            return false;
+
+        value = in.substr(pos, size);
+        pos += size;
+        return true;
+    }
+
+    auto rest() const -> StringView { return in.substr(pos); }
+
+    //--------------------------------------------------------------------
+private:
+    StringView in;
+    size_t pos = 0;
+};
+
+//------------------------------------------------------------------------
+auto encode_words(const MetaWords& words, StringType& block) -> void
+{
+    // Transcripts repeat their words a lot, each one is stored only once
+    std::unordered_map<StringView, uint64_t> string_ids;
+    std::vector<StringView> strings;
+    std::vector<uint64_t> word_ids;
+    word_ids.reserve(words.size());
+    for (const auto& word : words)
+    {
+        const auto [iter, inserted] =
+            string_ids.try_emplace(word.value, strings.size());
+        if (inserted)
+            strings.push_back(word.value);
+
+        word_ids.push_back(iter->second);
+    }
+
+    Writer writer(block);
+    writer.varint(strings.size());
+    for (const auto& string : strings)
+        writer.string(string);
+
+    for (const auto id : word_ids)
+        writer.varint(id);
+
+    // Words are sorted by their begin, the deltas are small
+    Ticks prev_begin = 0;
+    for (const auto& word : words)
+    {
+        const auto begin = to_ticks(word.begin);
+        writer.signed_varint(begin - prev_begin);
+        prev_begin = begin;
+    }
+
+    for (const auto& word : words)
+        writer.signed_varint(to_ticks(word.duration));
+}
+
+//------------------------------------------------------------------------
+auto decode_words(StringView block, uint64_t count, MetaWords& words) -> bool
+{
+    if (count > block.size() / MIN_BYTES_PER_WORD)
+        return false;
+
+    Reader reader(block);
+    uint64_t num_strings = 0;
+    if (!read_varint(reader, num_strings) || num_strings > block.size())
+        return false;
+
+    std::vector<StringView> strings(num_strings);
+    for (auto& string : strings)
+    {
+        if (!reader.string(string))
+            return false;
+    }
+
+    words.resize(count);
+    for (auto& word : words)
+    {
+        uint64_t id = 0;
+        if (!read_varint(reader, id) || id >= strings.size())
+            return false;
+
+        word.value = StringType(strings[id]);
+    }
+
+    Ticks begin = 0;
+    for (auto& word : words)
+    {
+        Ticks delta = 0;
+        if (!read_signed_varint(reader, delta))
+            return false;
+
+        begin += delta;
+        word.begin = to_seconds(begin);
+    }
+
+    for (auto& word : words)
+    {
+        Ticks duration = 0;
+        if (!read_signed_varint(reader, duration))
+            return false;
+
+        word.duration = to_seconds(duration);
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------
+auto compress_block(StringView raw, StringType& block) -> void
+{
+    Writer writer(block);
+    writer.varint(raw.size());
+    lz_codec::compress(raw, block);
+}
+
+//------------------------------------------------------------------------
+auto decompress_block(StringView block, StringType& raw) -> bool
+{
+    Reader reader(block);
+    uint64_t size = 0;
+    if (!read_varint(reader, size) ||
+        size / MAX_COMPRESSION_RATIO > reader.rest().size())
+        return false;
+
+    return lz_codec::decompress(reader.rest(), size, raw);
+}
+
+//------------------------------------------------------------------------
+auto encode_raw(const MetaWords& words) -> EncodedWordsPtr
+{
+    auto encoded   = std::make_shared<EncodedWords>();
+    encoded->count = words.size();
+    encode_words(words, encoded->block);
+
+    return encoded;
+}
+
+//------------------------------------------------------------------------
+auto to_compressed(const EncodedWords& raw) -> EncodedWordsPtr
+{
+    auto encoded           = std::make_shared<EncodedWords>();
+    encoded->count         = raw.count;
+    encoded->is_compressed = true;
+    compress_block(raw.block, encoded->block);
+
+    return encoded;
+}
+
+//------------------------------------------------------------------------
+auto is_archive(StringView s) -> bool
+{
+    return s.size() >= HEADER_SIZE &&
+           std::memcmp(s.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+//------------------------------------------------------------------------
+auto write_archive(EncodedAudioSources audio_sources, ChunkWriter& chunk_writer)
+    -> bool
+{
+    // All blocks of an archive are encoded alike, raw ones are compressed
+    // on the way if any other one is compressed already
+    const bool is_compressed = std::any_of(
+        audio_sources.begin(), audio_sources.end(),
+        [](const auto& audio_source) {
+            return audio_source.words->is_compressed;
+        });
+
+    if (is_compressed)
+    {
+        for (auto& audio_source : audio_sources)
+        {
+            if (!audio_source.words->is_compressed)
+                audio_source.words = to_compressed(*audio_source.words);
+        }
+    }
+
+    StringType head;
+    Writer writer(head);
+    writer.bytes(StringView(MAGIC, sizeof(MAGIC)));
+    writer.u32(BINARY_ARCHIVE_VERSION);
+    writer.u32(is_compressed ? COMPRESSED_BLOCKS : 0);
+    writer.u32(static_cast<uint32_t>(audio_sources.size()));
+
+    uint64_t offset = 0;
+    for (const auto& audio_source : audio_sources)
+    {
+        const auto& words = *audio_source.words;
+        writer.string(audio_source.persistent_id);
+        writer.varint(words.count);
+        writer.varint(offset);
+        writer.varint(words.block.size());
+        offset += words.block.size();
+    }
+
+    if (!chunk_writer.append(head))
+        return false;
+
+    // Blocks nobody else holds are released as soon as they are written
+    for (auto& audio_source : audio_sources)
+    {
+        if (!chunk_writer.append(audio_source.words->block))
+            return false;
+
+        audio_source.words.reset();
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------
+auto read_archive(ChunkReader& chunk_reader,
+                  const EncodedAudioSourceFunc& on_encoded_audio_source)
+    -> OptVersion
+{
+    uint32_t version     = 0;
+    uint32_t flags       = 0;
+    uint32_t num_sources = 0;
+    StringType head(sizeof(MAGIC), '\0');
+    if (!chunk_reader.read(head.size(), head.data()) ||
+        !read_u32(chunk_reader, version) || !read_u32(chunk_reader, flags) ||
+        !read_u32(chunk_reader, num_sources))
+        return {};
+
+    // Written by a newer version
+    if (version != BINARY_ARCHIVE_VERSION || (flags & ~KNOWN_FLAGS) != 0)
+        return {};
+
+    struct Entry
+    {
+        PersistentId persistent_id;
+        uint64_t count  = 0;
+        uint64_t offset = 0;
+        uint64_t size   = 0;
+    };
+
+    std::vector<Entry> entries;
+    for (uint32_t i = 0; i < num_sources; i++)
+    {
+        Entry entry;
+        uint64_t id_size = 0;
+        if (!read_varint(chunk_reader, id_size) ||
+            id_size > chunk_reader.remaining())
+            return {};
+
+        entry.persistent_id.resize(id_size);
+        if (!chunk_reader.read(id_size, entry.persistent_id.data()) ||
+            !read_varint(chunk_reader, entry.count) ||
+            !read_varint(chunk_reader, entry.offset) ||
+            !read_varint(chunk_reader, entry.size))
+            return {};
+
+        entries.push_back(std::move(entry));
+    }
+
+    // Blocks are handed on as they are, decoding them is up to the receiver
+    const auto blocks_position = chunk_reader.position();
+    for (auto& entry : entries)
+    {
+        if (!chunk_reader.seek(blocks_position + entry.offset) ||
+            entry.size > chunk_reader.remaining())
+            return {};
+
+        auto words           = std::make_shared<EncodedWords>();
+        words->count         = entry.count;
+        words->is_compressed = (flags & COMPRESSED_BLOCKS) != 0;
+        words->block.resize(entry.size);
+        if (!chunk_reader.read(words->block.size(), words->block.data()))
+            return {};
+
+        on_encoded_audio_source(
+            {std::move(entry.persistent_id), std::move(words)});
+    }
+
+    return version;
+}
+
+//------------------------------------------------------------------------
+} // namespace binary
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+// Feeds the JSON parser chunk by chunk
+//------------------------------------------------------------------------
+class ChunkStreamBuf : public std::streambuf
+{
+public:
+    //--------------------------------------------------------------------
+    explicit ChunkStreamBuf(ChunkReader& chunk_reader)
+    : chunk_reader(chunk_reader)
+    , buffer(ARCHIVE_CHUNK_SIZE, '\0')
+    {
+    }
+
+    //--------------------------------------------------------------------
+protected:
+    auto underflow() -> int_type override
+    {
+        const auto size = std::min(buffer.size(), chunk_reader.remaining());
+        if (size == 0 || !chunk_reader.read(size, buffer.data()))
+            return traits_type::eof();
+
+        setg(buffer.data(), buffer.data(), buffer.data() + size);
+        return traits_type::to_int_type(buffer.front());
+    }
+
+    //--------------------------------------------------------------------
+private:
+    ChunkReader& chunk_reader;
+    StringType buffer;
+};
+
+//------------------------------------------------------------------------
+// Builds the audio sources of a version 1 archive while it is parsed, each
+// one is handed on as soon as its object is closed.
+//
+// {"archive_version": 1, "audio_sources": [{"persistent_id": "...",
+//  "words": [{"begin": 0.0, "duration": 0.0, "word": "..."}, ...]}, ...]}
+//------------------------------------------------------------------------
+class JsonArchiveHandler : public nlohmann::json_sax<json>
+{
+public:
+    //--------------------------------------------------------------------
+    explicit JsonArchiveHandler(const AudioSourceFunc& on_audio_source)
+    : on_audio_source(on_audio_source)
+    {
+    }
+
+    size_t version = 0;
+
+    auto null() -> bool override { return true; }
+    auto boolean(bool) -> bool override { return true; }
+    auto number_integer(number_integer_t value) -> bool override
+    {
+        return number(static_cast<double>(value));
+    }
+    auto number_unsigned(number_unsigned_t value) -> bool override
+    {
+        return number(static_cast<double>(value));
+    }
+    auto number_float(number_float_t value, const string_t&) -> bool override
+    {
+        return number(static_cast<double>(value));
+    }
+    auto string(string_t& value) -> bool override
+    {
+        if (is_source() && current_key == "persistent_id")
+            audio_source.persistent_id = std::move(value);
+        else if (is_word() && current_key == "word")
+            word.value = std::move(value);
+
+        return true;
+    }
+    auto binary(binary_t&) -> bool override { return true; }
+
+    auto start_object(size_t) -> bool override
+    {
+        depth++;
+        if (is_source())
+            audio_source = {};
+        else if (is_word())
+            word = {};
+
+        return true;
+    }
+    auto key(string_t& value) -> bool override
+    {
+        current_key = std::move(value);
+        return true;
+    }
+    auto end_object() -> bool override
+    {
+        if (is_word())
+            audio_source.words.push_back(std::move(word));
+        else if (is_source())
+            on_audio_source(std::move(audio_source));
+
+        depth--;
+        return true;
+    }
+    auto start_array(size_t) -> bool override
+    {
+        depth++;
+        if (depth == SOURCES_DEPTH && current_key == "audio_sources")
+            in_sources = true;
+        else if (depth == WORDS_DEPTH && in_sources && current_key == "words")
+            in_words = true;
+
+        return true;
+    }
+    auto end_array() -> bool override
+    {
+        if (depth == SOURCES_DEPTH)
+            in_sources = false;
+        else if (depth == WORDS_DEPTH)
+            in_words = false;
+
+        depth--;
+        return true;
+    }
+    auto parse_error(size_t,
+                     const std::string&,
+                     const nlohmann::detail::exception&) -> bool override
+    {
+        return false;
+    }
+
+    //--------------------------------------------------------------------
+private:
+    // Nesting of the archive object, its sources array, a source object,
+    // its words array and a word object
+    static constexpr size_t ARCHIVE_DEPTH = 1;
+    static constexpr size_t SOURCES_DEPTH = 2;
+    static constexpr size_t SOURCE_DEPTH  = 3;
+    static constexpr size_t WORDS_DEPTH   = 4;
+    static constexpr size_t WORD_DEPTH    = 5;
+
+    auto is_source() const -> bool
+    {
+        return in_sources && depth == SOURCE_DEPTH;
+    }
+    auto is_word() const -> bool { return in_words && depth == WORD_DEPTH; }
+
+    auto number(double value) -> bool
+    {
+        if (depth == ARCHIVE_DEPTH && current_key == "archive_version")
+            version = static_cast<size_t>(value);
+        else if (is_word() && current_key == "begin")
+            word.begin = value;
+        else if (is_word() && current_key == "duration")
+            word.duration = value;
+
+        return true;
+    }
+
+    const AudioSourceFunc& on_audio_source;
+    size_t depth     = 0;
+    bool in_sources  = false;
+    bool in_words    = false;
+    string_t current_key;
+    AudioSource audio_source;
+    MetaWord word;
+};
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+auto encode(const MetaWords& words) -> EncodedWordsPtr
+{
+    return binary::to_compressed(*binary::encode_raw(words));
+}
+
+//------------------------------------------------------------------------
+auto write_chunked(const Archive& archive, const WriteFunc& write) -> bool
+{
+    if (archive.version == BINARY_ARCHIVE_VERSION)
+    {
+        // The index needs the size of every block up front
+        EncodedAudioSources audio_sources;
+        audio_sources.reserve(archive.audio_sources.size());
+        for (const auto& audio_source : archive.audio_sources)
+            audio_sources.push_back(
+                {audio_source.persistent_id,
+                 archive.compress_blocks
+                     ? encode(audio_source.words)
+                     : binary::encode_raw(audio_source.words)});
+
+        return write_chunked(std::move(audio_sources), write);
+    }
+
+    ChunkWriter chunk_writer(write);
+    json j = archive;
+    return chunk_writer.append(j.dump()) && chunk_writer.flush();
+}
+
+//------------------------------------------------------------------------
+auto write_chunked(EncodedAudioSources audio_sources, const WriteFunc& write)
+    -> bool
+{
+    ChunkWriter chunk_writer(write);
+    return binary::write_archive(std::move(audio_sources), chunk_writer) &&
+           chunk_writer.flush();
+}
+
+//------------------------------------------------------------------------
+auto decode(const EncodedWords& encoded, MetaWords& words) -> bool
+{
+    if (!encoded.is_compressed)
+        return binary::decode_words(encoded.block, encoded.count, words);
+
+    StringType raw;
+    return binary::decompress_block(encoded.block, raw) &&
+           binary::decode_words(raw, encoded.count, words);
+}
+
+//------------------------------------------------------------------------
+auto read_chunked(size_t archive_size,
+                  const ReadFunc& read,
+                  const AudioSourceFunc& on_audio_source) -> OptVersion
+{
+    bool is_valid         = true;
+    const auto on_encoded = [&](EncodedAudioSource&& encoded) {
+        AudioSource audio_source{std::move(encoded.persistent_id), {}};
+        if (is_valid && decode(*encoded.words, audio_source.words))
+            on_audio_source(std::move(audio_source));
+        else
+            is_valid = false;
+    };
+
+    const auto version =
+        read_chunked(archive_size, read, on_audio_source, on_encoded);
+    return is_valid ? version : OptVersion();
+}
+
+//------------------------------------------------------------------------
+auto read_chunked(size_t archive_size,
+                  const ReadFunc& read,
+                  const AudioSourceFunc& on_audio_source,
+                  const EncodedAudioSourceFunc& on_encoded_audio_source)
+    -> OptVersion
+{
+    ChunkReader chunk_reader(archive_size, read);
+    if (binary::is_archive(chunk_reader.peek(binary::HEADER_SIZE)))
+        return binary::read_archive(chunk_reader, on_encoded_audio_source);
+
+    // Version 1 archives are JSON
+    ChunkStreamBuf stream_buf(chunk_reader);
+    std::istream stream(&stream_buf);
+    JsonArchiveHandler handler(on_audio_source);
+    if (!json::sax_parse(stream, &handler) || handler.version == 0)
+        return {};
+
+    return handler.version;
+}
+
+//------------------------------------------------------------------------
+auto serialize(const Archive& archive, JsonString& s) -> bool
+{
+    s.clear();
+    return write_chunked(
+        archive, [&](size_t /*position*/, size_t size, const char* data) {
+            s.append(data, size);
+            return true;
+        });
+}
+
 //------------------------------------------------------------------------
 auto deserialize(const JsonString& s, Archive& archive) -> bool
 {
     if (s.empty())
         return false;
 
-    json j  = json::parse(s);
-    archive = j.template get<Archive>();
+    Archive result;
+    const auto version = read_chunked(
+        s.size(),
+        [&](size_t position, size_t size, char* data) {
+            std::memcpy(data, s.data() + position, size);
+            return true;
+        },
+        [&](AudioSource&& audio_source) {
+            result.audio_sources.push_back(std::move(audio_source));
+        });
 
+    if (!version)
+        return false;
+
+    result.version = version.value();
+    archive        = std::move(result);
     return true;
 }
+
 //------------------------------------------------------------------------
 } // namespace serde
 } // namespace mam::meta_words
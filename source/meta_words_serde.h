@@ -6,6 +6,9 @@
 
 #include "mam/meta_words/meta_word.h"
 #include "wordify_types.h"
+#include <functional>
+#include <memory>
+#include <optional>
 
 namespace mam::meta_words::serde {
 //------------------------------------------------------------------------
@@ -17,16 +20,90 @@ struct AudioSource
     MetaWords words;
 };
 
+constexpr size_t JSON_ARCHIVE_VERSION   = 1;
+constexpr size_t BINARY_ARCHIVE_VERSION = 2;
+
 struct Archive
 {
     using AudioSources = std::vector<AudioSource>;
 
-    size_t version = 1;
+    size_t version = BINARY_ARCHIVE_VERSION;
     AudioSources audio_sources;
+
+    /** Binary archives only, see EncodedWords */
+    bool compress_blocks = true;
+};
+
+/** Words of an audio source in the binary format, the block of its archive
+ *  entry. Compressed blocks are smaller, decoding them takes one more pass
+ *  over the bytes. */
+struct EncodedWords
+{
+    size_t count       = 0;
+    bool is_compressed = false;
+    StringType block;
+};
+
+using EncodedWordsPtr = std::shared_ptr<const EncodedWords>;
+
+struct EncodedAudioSource
+{
+    PersistentId persistent_id;
+    EncodedWordsPtr words;
 };
 
+using EncodedAudioSources = std::vector<EncodedAudioSource>;
+
 //------------------------------------------------------------------------
+constexpr size_t ARCHIVE_CHUNK_SIZE = 64 * 1024;
+
+/** Read or write size bytes at position of the archive */
+using ReadFunc  = std::function<bool(size_t position, size_t size, char* data)>;
+using WriteFunc =
+    std::function<bool(size_t position, size_t size, const char* data)>;
+using AudioSourceFunc = std::function<void(AudioSource&& audio_source)>;
+using EncodedAudioSourceFunc =
+    std::function<void(EncodedAudioSource&& audio_source)>;
+using OptVersion = std::optional<size_t>;
+
+/** Writes the archive in the format of its version, in consecutive chunks
+ *  of ARCHIVE_CHUNK_SIZE bytes. The binary format stores timestamps with a
+ *  resolution of one microsecond. */
+auto write_chunked(const Archive& archive, const WriteFunc& write) -> bool;
+
+/** Encodes words into a compressed block for a binary archive. Blocks can
+ *  be kept and written again as long as the words do not change. */
+auto encode(const MetaWords& words) -> EncodedWordsPtr;
+
+/** Writes a binary archive of audio sources encoded before */
+auto write_chunked(EncodedAudioSources audio_sources, const WriteFunc& write)
+    -> bool;
+
+/** Reads both formats chunk by chunk, JSON archives start with '{'. Every
+ *  audio source is handed on as soon as it is read, so the whole archive is
+ *  never in memory at once. Returns the version of the archive, none if it
+ *  is truncated or unknown. Audio sources read up to then have been handed
+ *  on already. */
+auto read_chunked(size_t archive_size,
+                  const ReadFunc& read,
+                  const AudioSourceFunc& on_audio_source) -> OptVersion;
+
+/** Same as above, but the words of binary archives are handed on still
+ *  encoded, see decode. Only their blocks are read, which is a copy. JSON
+ *  archives are decoded while reading anyway and go to on_audio_source. */
+auto read_chunked(size_t archive_size,
+                  const ReadFunc& read,
+                  const AudioSourceFunc& on_audio_source,
+                  const EncodedAudioSourceFunc& on_encoded_audio_source)
+    -> OptVersion;
+
+/** Returns false if the block is corrupt */
+auto decode(const EncodedWords& encoded, MetaWords& words) -> bool;
+
+/** Same as write_chunked, into memory */
 auto serialize(const Archive& archive, StringType& s) -> bool;
+
+/** Same as read_chunked, from memory */
 auto deserialize(const StringType& s, Archive& archive) -> bool;
 
 //------------------------------------------------------------------------
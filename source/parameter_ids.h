@@ -16,6 +16,7 @@ enum ParamIds
     kParamIdSmartSearchMode,
     kParamIdSmartSearchNext,
     kParamIdSmartSearchPrev,
+    kParamIdSmartSearchMethod,
 };
 
 //------------------------------------------------------------------------
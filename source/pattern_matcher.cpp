@@ -0,0 +1,873 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "pattern_matcher.h"
+#include "text_normalizer.h"
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <utility>
+
+namespace mam {
+namespace {
+
+//------------------------------------------------------------------------
+using StringView = PatternMatcher::StringView;
+
+//------------------------------------------------------------------------
+// Thompson NFA, states are referred to by index
+struct NfaState
+{
+    enum class Kind
+    {
+        Range,
+        Split,
+        Epsilon,
+        Match
+    };
+
+    Kind kind  = Kind::Epsilon;
+    uint8_t lo = 0;
+    uint8_t hi = 0;
+    int out    = -1;
+    int out1   = -1;
+};
+
+using NfaStates = std::vector<NfaState>;
+using StateSet  = std::vector<int>;
+
+//------------------------------------------------------------------------
+// A partially built NFA. Its dangling outs are patched to whatever follows.
+struct Fragment
+{
+    using Outs = std::vector<std::pair<int, bool>>; // State, is out1
+
+    int start = -1;
+    Outs outs;
+};
+
+using OptFragment = std::optional<Fragment>;
+using AsciiSet    = std::bitset<128>;
+
+//------------------------------------------------------------------------
+constexpr StringView META_CHARACTERS = "\\.[]()|*+?{}^$/";
+
+//------------------------------------------------------------------------
+auto utf8_length(char lead) -> size_t
+{
+    const auto byte = static_cast<unsigned char>(lead);
+    if ((byte & 0xE0) == 0xC0)
+        return 2;
+    if ((byte & 0xF0) == 0xE0)
+        return 3;
+    if ((byte & 0xF8) == 0xF0)
+        return 4;
+
+    return 1;
+}
+
+//------------------------------------------------------------------------
+auto trim(StringView text) -> StringView
+{
+    const auto first = text.find_first_not_of(" \t\r\n");
+    if (first == StringView::npos)
+        return {};
+
+    const auto last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+
+//------------------------------------------------------------------------
+auto is_regex(StringView query) -> bool
+{
+    return query.size() > 2 && query.front() == '/' && query.back() == '/';
+}
+
+//------------------------------------------------------------------------
+// A question mark ending the query is punctuation as in "what?", not a
+// wildcard
+auto strip_question_marks(StringView wildcard) -> StringView
+{
+    const auto last = wildcard.find_last_not_of('?');
+    return last == StringView::npos ? StringView{}
+                                    : trim(wildcard.substr(0, last + 1));
+}
+
+//------------------------------------------------------------------------
+// "gonna*" becomes "gonna\S*", so wildcards stay within a word. Whitespace
+// collapses to single spaces.
+auto wildcard_to_regex(StringView wildcard) -> StringType
+{
+    StringType regex;
+    bool is_space = false;
+    for (const auto c : wildcard)
+    {
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+        {
+            is_space = true;
+            continue;
+        }
+
+        if (is_space)
+            regex.push_back(' ');
+        is_space = false;
+
+        if (c == '*')
+            regex += "\\S*";
+        else if (c == '?')
+            regex += "\\S";
+        else if (META_CHARACTERS.find(c) != StringView::npos)
+            regex += {'\\', c};
+        else
+            regex.push_back(c);
+    }
+
+    return regex;
+}
+
+//------------------------------------------------------------------------
+// Parser
+//
+// Recursive descent over the pattern, emitting NFA states on the way. Fails
+// on syntax errors and as soon as one of the limits is exceeded.
+//------------------------------------------------------------------------
+class Parser
+{
+public:
+    //--------------------------------------------------------------------
+    Parser(StringView pattern, NfaStates& states, size_t depth)
+    : pattern(pattern)
+    , states(states)
+    , depth(depth)
+    {
+    }
+
+    auto parse() -> OptFragment
+    {
+        auto fragment = parse_alternation();
+        if (failed || pos != pattern.size())
+            return std::nullopt;
+
+        return fragment;
+    }
+
+    //--------------------------------------------------------------------
+private:
+    auto parse_alternation() -> OptFragment;
+    auto parse_concatenation() -> OptFragment;
+    auto parse_repetition() -> OptFragment;
+    auto parse_atom() -> OptFragment;
+    auto parse_class() -> OptFragment;
+    auto parse_escape() -> OptFragment;
+    auto parse_literal() -> OptFragment;
+    auto parse_count() -> std::optional<size_t>;
+    auto repeat(Fragment&& fragment, StringView atom) -> OptFragment;
+
+    auto fail() -> OptFragment
+    {
+        failed = true;
+        return std::nullopt;
+    }
+
+    auto peek() const -> char
+    {
+        return pos < pattern.size() ? pattern[pos] : '\0';
+    }
+    auto at_end() const -> bool { return pos >= pattern.size(); }
+
+    auto add_state(NfaState state) -> int;
+    auto patch(const Fragment::Outs& outs, int target) -> void;
+
+    auto range(uint8_t lo, uint8_t hi) -> Fragment;
+    auto epsilon() -> Fragment;
+    auto sequence(StringView bytes) -> Fragment;
+    auto concat(Fragment&& a, Fragment&& b) -> Fragment;
+    auto alternate(Fragment&& a, Fragment&& b) -> Fragment;
+    auto star(Fragment&& a) -> Fragment;
+    auto plus(Fragment&& a) -> Fragment;
+    auto optional(Fragment&& a) -> Fragment;
+    auto multi_byte() -> Fragment;
+    auto char_class(const AsciiSet& ascii,
+                    bool with_multi_byte,
+                    const std::vector<StringType>& sequences) -> OptFragment;
+
+    StringView pattern;
+    size_t pos = 0;
+    NfaStates& states;
+    size_t depth = 0;
+    bool failed  = false;
+};
+
+//------------------------------------------------------------------------
+auto Parser::add_state(NfaState state) -> int
+{
+    if (states.size() >= PatternMatcher::MAX_NFA_STATES)
+        failed = true;
+
+    states.push_back(state);
+    return static_cast<int>(states.size() - 1);
+}
+
+//------------------------------------------------------------------------
+auto Parser::patch(const Fragment::Outs& outs, int target) -> void
+{
+    for (const auto& [state, is_out1] : outs)
+        (is_out1 ? states[state].out1 : states[state].out) = target;
+}
+
+//------------------------------------------------------------------------
+auto Parser::range(uint8_t lo, uint8_t hi) -> Fragment
+{
+    const auto state = add_state({NfaState::Kind::Range, lo, hi});
+    return {state, {{state, false}}};
+}
+
+//------------------------------------------------------------------------
+auto Parser::epsilon() -> Fragment
+{
+    const auto state = add_state({NfaState::Kind::Epsilon});
+    return {state, {{state, false}}};
+}
+
+//------------------------------------------------------------------------
+auto Parser::sequence(StringView bytes) -> Fragment
+{
+    if (bytes.empty())
+        return epsilon();
+
+    auto result = range(static_cast<uint8_t>(bytes[0]),
+                        static_cast<uint8_t>(bytes[0]));
+    for (size_t i = 1; i < bytes.size(); i++)
+    {
+        const auto byte = static_cast<uint8_t>(bytes[i]);
+        result          = concat(std::move(result), range(byte, byte));
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto Parser::concat(Fragment&& a, Fragment&& b) -> Fragment
+{
+    patch(a.outs, b.start);
+    return {a.start, std::move(b.outs)};
+}
+
+//------------------------------------------------------------------------
+auto Parser::alternate(Fragment&& a, Fragment&& b) -> Fragment
+{
+    const auto state =
+        add_state({NfaState::Kind::Split, 0, 0, a.start, b.start});
+    auto outs = std::move(a.outs);
+    outs.insert(outs.end(), b.outs.begin(), b.outs.end());
+
+    return {state, std::move(outs)};
+}
+
+//------------------------------------------------------------------------
+auto Parser::star(Fragment&& a) -> Fragment
+{
+    const auto state = add_state({NfaState::Kind::Split, 0, 0, a.start});
+    patch(a.outs, state);
+
+    return {state, {{state, true}}};
+}
+
+//------------------------------------------------------------------------
+auto Parser::plus(Fragment&& a) -> Fragment
+{
+    const auto state = add_state({NfaState::Kind::Split, 0, 0, a.start});
+    patch(a.outs, state);
+
+    return {a.start, {{state, true}}};
+}
+
+//------------------------------------------------------------------------
+auto Parser::optional(Fragment&& a) -> Fragment
+{
+    const auto state = add_state({NfaState::Kind::Split, 0, 0, a.start});
+    auto outs        = std::move(a.outs);
+    outs.emplace_back(state, true);
+
+    return {state, std::move(outs)};
+}
+
+//------------------------------------------------------------------------
+auto Parser::multi_byte() -> Fragment
+{
+    // Any UTF-8 sequence of two, three or four bytes
+    const auto tail = [this]() { return range(0x80, 0xBF); };
+
+    auto two   = concat(range(0xC2, 0xDF), tail());
+    auto three = concat(concat(range(0xE0, 0xEF), tail()), tail());
+    auto four =
+        concat(concat(concat(range(0xF0, 0xF4), tail()), tail()), tail());
+
+    return alternate(std::move(two),
+                     alternate(std::move(three), std::move(four)));
+}
+
+//------------------------------------------------------------------------
+auto Parser::char_class(const AsciiSet& ascii,
+                        bool with_multi_byte,
+                        const std::vector<StringType>& sequences)
+    -> OptFragment
+{
+    OptFragment result;
+    const auto add = [&](Fragment&& fragment) {
+        result = result ? alternate(std::move(*result), std::move(fragment))
+                        : std::move(fragment);
+    };
+
+    // Runs of consecutive characters become one range
+    for (size_t c = 0; c < ascii.size(); c++)
+    {
+        if (!ascii[c])
+            continue;
+
+        auto last = c;
+        while (last + 1 < ascii.size() && ascii[last + 1])
+            last++;
+
+        add(range(static_cast<uint8_t>(c), static_cast<uint8_t>(last)));
+        c = last;
+    }
+
+    if (with_multi_byte)
+        add(multi_byte());
+
+    for (const auto& bytes : sequences)
+        add(sequence(bytes));
+
+    if (!result)
+        return fail(); // e.g. "[^\d\D]"
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto Parser::parse_alternation() -> OptFragment
+{
+    if (++depth > PatternMatcher::MAX_NESTING)
+        return fail();
+
+    auto result = parse_concatenation();
+    while (result && peek() == '|')
+    {
+        pos++;
+        auto next = parse_concatenation();
+        if (!next)
+            return fail();
+
+        result = alternate(std::move(*result), std::move(*next));
+    }
+
+    depth--;
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto Parser::parse_concatenation() -> OptFragment
+{
+    OptFragment result;
+    while (!at_end() && peek() != '|' && peek() != ')' && !failed)
+    {
+        auto next = parse_repetition();
+        if (!next)
+            return fail();
+
+        result = result ? concat(std::move(*result), std::move(*next))
+                        : std::move(next);
+    }
+
+    if (failed)
+        return std::nullopt;
+
+    // Empty branch e.g. "(a|)"
+    return result ? result : epsilon();
+}
+
+//------------------------------------------------------------------------
+auto Parser::parse_repetition() -> OptFragment
+{
+    const auto atom_begin = pos;
+    auto result           = parse_atom();
+    if (!result)
+        return fail();
+
+    const auto atom = pattern.substr(atom_begin, pos - atom_begin);
+    bool is_quantified = false;
+    while (!failed)
+    {
+        const auto c = peek();
+        if (c == '*')
+            result = star(std::move(*result));
+        else if (c == '+')
+            result = plus(std::move(*result));
+        else if (c == '?')
+            result = optional(std::move(*result));
+        else if (c == '{' && !is_quantified)
+        {
+            pos++;
+            result = repeat(std::move(*result), atom);
+            if (!result)
+                return fail();
+
+            is_quantified = true;
+            continue;
+        }
+        else
+            break;
+
+        pos++;
+        is_quantified = true;
+    }
+
+    if (failed)
+        return std::nullopt;
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto Parser::parse_count() -> std::optional<size_t>
+{
+    size_t count  = 0;
+    const auto at = pos;
+    while (peek() >= '0' && peek() <= '9')
+    {
+        count = count * 10 + static_cast<size_t>(peek() - '0');
+        if (count > PatternMatcher::MAX_REPETITIONS)
+            return std::nullopt;
+        pos++;
+    }
+
+    if (pos == at)
+        return std::nullopt;
+
+    return count;
+}
+
+//------------------------------------------------------------------------
+auto Parser::repeat(Fragment&& fragment, StringView atom) -> OptFragment
+{
+    // "{m}", "{m,}" or "{m,n}", the opening brace is consumed already
+    const auto min = parse_count();
+    if (!min)
+        return std::nullopt;
+
+    std::optional<size_t> max = min;
+    if (peek() == ',')
+    {
+        pos++;
+        max = peek() == '}' ? std::nullopt : parse_count();
+        if (peek() != '}' && !max)
+            return std::nullopt;
+    }
+
+    if (peek() != '}' || (max && *max < *min))
+        return std::nullopt;
+    pos++;
+
+    // Every copy needs its own states, so the atom is parsed again
+    const auto copy = [&]() -> OptFragment {
+        return Parser(atom, states, depth).parse();
+    };
+
+    OptFragment result;
+    const auto append = [&](Fragment&& next) {
+        result = result ? concat(std::move(*result), std::move(next))
+                        : std::move(next);
+    };
+
+    for (size_t i = 0; i < *min; i++)
+    {
+        auto next = i == 0 ? OptFragment(std::move(fragment)) : copy();
+        if (!next)
+            return std::nullopt;
+        append(std::move(*next));
+    }
+
+    const auto count_optional = max ? *max - *min : 1;
+    for (size_t i = 0; i < count_optional; i++)
+    {
+        auto next = (*min == 0 && i == 0) ? OptFragment(std::move(fragment))
+                                          : copy();
+        if (!next)
+            return std::nullopt;
+        append(max ? optional(std::move(*next)) : star(std::move(*next)));
+    }
+
+    if (failed)
+        return std::nullopt;
+
+    return result ? result : epsilon(); // "{0}"
+}
+
+//------------------------------------------------------------------------
+auto Parser::parse_atom() -> OptFragment
+{
+    // Nested repetitions grow the NFA exponentially
+    if (states.size() >= PatternMatcher::MAX_NFA_STATES)
+        return fail();
+
+    switch (peek())
+    {
+        case '(': {
+            pos++;
+            auto result = parse_alternation();
+            if (!result || peek() != ')')
+                return fail();
+
+            pos++;
+            return result;
+        }
+        case '[': pos++; return parse_class();
+        case '\\': pos++; return parse_escape();
+        case '.': {
+            // Any code point, a space too. Hits are limited to a few words
+            // by the SearchEngine.
+            pos++;
+            AsciiSet ascii;
+            ascii.set();
+            return char_class(ascii, true, {});
+        }
+        case '^':
+        case '$':
+            // Matches are always anchored
+            pos++;
+            return epsilon();
+        case ')':
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+        case '|': return fail();
+        default: return parse_literal();
+    }
+}
+
+//------------------------------------------------------------------------
+auto Parser::parse_literal() -> OptFragment
+{
+    const auto length = std::min(utf8_length(peek()), pattern.size() - pos);
+    const auto code_point = pattern.substr(pos, length);
+    pos += length;
+
+    // Punctuation normalizes to nothing, just like in the transcript
+    return sequence(text_normalizer::normalize(code_point));
+}
+
+//------------------------------------------------------------------------
+auto Parser::parse_escape() -> OptFragment
+{
+    if (at_end())
+        return fail();
+
+    AsciiSet digits;
+    for (char c = '0'; c <= '9'; c++)
+        digits.set(c);
+
+    AsciiSet word = digits;
+    for (char c = 'a'; c <= 'z'; c++)
+        word.set(c);
+    word.set('_');
+
+    AsciiSet space;
+    space.set(' ');
+
+    // Negations stay within a word
+    const auto negate = [&](AsciiSet ascii) {
+        ascii.flip();
+        ascii.reset(' ');
+        return ascii;
+    };
+
+    switch (pattern[pos++])
+    {
+        case 'd': return char_class(digits, false, {});
+        case 'D': return char_class(negate(digits), true, {});
+        case 'w': return char_class(word, true, {});
+        case 'W': return char_class(negate(word), false, {});
+        case 's': return char_class(space, false, {});
+        case 'S': return char_class(negate(space), true, {});
+        default: pos--; return parse_literal();
+    }
+}
+
+//------------------------------------------------------------------------
+auto Parser::parse_class() -> OptFragment
+{
+    // The opening bracket is consumed already
+    bool is_negated = peek() == '^';
+    if (is_negated)
+        pos++;
+
+    AsciiSet ascii;
+    bool with_multi_byte = false;
+    std::vector<StringType> sequences;
+
+    const auto add_code_point = [&](StringView code_point) {
+        const auto normalized = text_normalizer::normalize(code_point);
+        if (normalized.size() == 1)
+            ascii.set(static_cast<unsigned char>(normalized[0]));
+        else if (!normalized.empty())
+            sequences.push_back(normalized);
+    };
+
+    bool is_first = true;
+    while (!at_end() && (peek() != ']' || is_first))
+    {
+        is_first = false;
+        if (peek() == '\\')
+        {
+            pos++;
+            if (at_end())
+                return fail();
+
+            const auto c = pattern[pos++];
+            if (c == 'd' || c == 'w')
+            {
+                for (char d = '0'; d <= '9'; d++)
+                    ascii.set(d);
+            }
+            if (c == 'w')
+            {
+                for (char l = 'a'; l <= 'z'; l++)
+                    ascii.set(l);
+                ascii.set('_');
+                with_multi_byte = true;
+            }
+            if (c == 's')
+                ascii.set(' ');
+            if (c != 'd' && c != 'w' && c != 's')
+                add_code_point(pattern.substr(pos - 1, 1));
+            continue;
+        }
+
+        const auto length =
+            std::min(utf8_length(peek()), pattern.size() - pos);
+        const auto first = pattern.substr(pos, length);
+        pos += length;
+
+        const bool is_range = peek() == '-' && pos + 1 < pattern.size() &&
+                              pattern[pos + 1] != ']';
+        if (!is_range)
+        {
+            add_code_point(first);
+            continue;
+        }
+
+        // Ranges of ASCII characters only
+        pos++;
+        const auto last = static_cast<unsigned char>(pattern[pos++]);
+        const auto lo   = static_cast<unsigned char>(first[0]);
+        if (length != 1 || last >= 0x80 || last < lo)
+            return fail();
+
+        for (auto c = lo; c <= last; c++)
+        {
+            ascii.set(c);
+            if (c >= 'A' && c <= 'Z')
+                ascii.set(c - 'A' + 'a');
+        }
+    }
+
+    if (peek() != ']')
+        return fail();
+    pos++;
+
+    if (is_negated)
+    {
+        // Only ASCII members can be excluded
+        if (!sequences.empty() || with_multi_byte)
+            return fail();
+
+        ascii.flip();
+        ascii.reset(' ');
+        with_multi_byte = true;
+    }
+
+    return char_class(ascii, with_multi_byte, sequences);
+}
+
+//------------------------------------------------------------------------
+auto closure(const NfaStates& states, StateSet seeds) -> StateSet
+{
+    // Only Range and Match states are kept, they define the DFA state
+    StateSet result;
+    std::vector<bool> visited(states.size(), false);
+    while (!seeds.empty())
+    {
+        const auto state = seeds.back();
+        seeds.pop_back();
+        if (state < 0 || visited[state])
+            continue;
+
+        visited[state]    = true;
+        const auto& nfa_state = states[state];
+        switch (nfa_state.kind)
+        {
+            case NfaState::Kind::Split:
+                seeds.push_back(nfa_state.out1);
+                seeds.push_back(nfa_state.out);
+                break;
+            case NfaState::Kind::Epsilon:
+                seeds.push_back(nfa_state.out);
+                break;
+            default: result.push_back(state); break;
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// PatternMatcher
+//------------------------------------------------------------------------
+auto PatternMatcher::is_pattern(StringView query) -> bool
+{
+    query = trim(query);
+    return is_regex(query) ||
+           strip_question_marks(query).find_first_of("*?") != StringView::npos;
+}
+
+//------------------------------------------------------------------------
+auto PatternMatcher::create(StringView query) -> PatternMatcherPtr
+{
+    query = trim(query);
+    if (query.size() > MAX_PATTERN_LENGTH || !is_pattern(query))
+        return nullptr;
+
+    if (is_regex(query))
+        return compile(query.substr(1, query.size() - 2));
+
+    return compile(wildcard_to_regex(strip_question_marks(query)));
+}
+
+//------------------------------------------------------------------------
+auto PatternMatcher::compile(StringView regex) -> PatternMatcherPtr
+{
+    NfaStates states;
+    auto fragment = Parser(regex, states, 0).parse();
+    if (!fragment || states.size() >= MAX_NFA_STATES)
+        return nullptr;
+
+    const auto match = static_cast<int>(states.size());
+    states.push_back({NfaState::Kind::Match});
+    for (const auto& [state, is_out1] : fragment->outs)
+        (is_out1 ? states[state].out1 : states[state].out) = match;
+
+    auto matcher = std::shared_ptr<PatternMatcher>(new PatternMatcher);
+    matcher->is_multi_word =
+        std::any_of(states.begin(), states.end(), [](const auto& state) {
+            return state.kind == NfaState::Kind::Range && state.lo <= ' ' &&
+                   ' ' <= state.hi;
+        });
+
+    // Subset construction, the empty set is the dead state
+    std::vector<StateSet> sets{{}, closure(states, {fragment->start})};
+    std::map<StateSet, State> ids{{sets[0], DEAD_STATE},
+                                  {sets[1], START_STATE}};
+    matcher->transitions.assign(sets.size() * 256, DEAD_STATE);
+
+    for (size_t id = START_STATE; id < sets.size(); id++)
+    {
+        // Bytes between two boundaries all lead to the same set
+        std::vector<int> boundaries{0, 256};
+        for (const auto state : sets[id])
+        {
+            if (states[state].kind != NfaState::Kind::Range)
+                continue;
+
+            boundaries.push_back(states[state].lo);
+            boundaries.push_back(states[state].hi + 1);
+        }
+
+        std::sort(boundaries.begin(), boundaries.end());
+        boundaries.erase(std::unique(boundaries.begin(), boundaries.end()),
+                         boundaries.end());
+
+        for (size_t i = 0; i + 1 < boundaries.size(); i++)
+        {
+            const auto byte = boundaries[i];
+            StateSet seeds;
+            for (const auto state : sets[id])
+            {
+                const auto& nfa_state = states[state];
+                if (nfa_state.kind == NfaState::Kind::Range &&
+                    nfa_state.lo <= byte && byte <= nfa_state.hi)
+                    seeds.push_back(nfa_state.out);
+            }
+
+            if (seeds.empty())
+                continue;
+
+            auto target = closure(states, std::move(seeds));
+            auto iter   = ids.find(target);
+            if (iter == ids.end())
+            {
+                if (sets.size() >= MAX_DFA_STATES)
+                    return nullptr;
+
+                iter = ids.emplace(target, static_cast<State>(sets.size()))
+                           .first;
+                sets.push_back(std::move(target));
+                matcher->transitions.resize(sets.size() * 256, DEAD_STATE);
+            }
+
+            std::fill(matcher->transitions.begin() + id * 256 + byte,
+                      matcher->transitions.begin() + id * 256 +
+                          boundaries[i + 1],
+                      iter->second);
+        }
+    }
+
+    matcher->accepting.resize(sets.size());
+    for (size_t id = 0; id < sets.size(); id++)
+    {
+        matcher->accepting[id] =
+            std::binary_search(sets[id].begin(), sets[id].end(), match);
+    }
+
+    return matcher;
+}
+
+//------------------------------------------------------------------------
+auto PatternMatcher::is_match(StringView text) const -> bool
+{
+    auto state = START_STATE;
+    for (const auto c : text)
+    {
+        state = next(state, c);
+        if (state == DEAD_STATE)
+            return false;
+    }
+
+    return accepting[state];
+}
+
+//------------------------------------------------------------------------
+auto PatternMatcher::longest_match(StringView words) const -> OptLength
+{
+    OptLength length;
+    auto state = START_STATE;
+    for (size_t i = 0; i < words.size(); i++)
+    {
+        state = next(state, words[i]);
+        if (state == DEAD_STATE)
+            break;
+
+        const bool is_word_end = i + 1 == words.size() || words[i + 1] == ' ';
+        if (accepting[state] && is_word_end)
+            length = i + 1;
+    }
+
+    return length;
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,92 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "wordify_types.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// PatternMatcher
+//
+// Search query compiled once to a DFA over the bytes of normalized text.
+// A query enclosed in slashes like "/um|uh|erm/" is a regular expression,
+// one containing '*' or '?' like "gonna*" a wildcard pattern. Question
+// marks ending the query are punctuation, so "what?" stays a plain query.
+// Wildcards never match across words.
+//
+// Supported: literals, '.', classes "[a-z]" and "[^0-9]", "\d", "\w", "\s",
+// groups, '|', '*', '+', '?' and "{m,n}". Matches are always anchored, to
+// the whole word or to whole words. Literals are normalized just like the
+// transcript, '.' and classes match whole UTF-8 code points.
+//
+// '.' matches a space as well, so "/thank .* much/" finds "thank you so
+// much". Such a pattern spans words and is matched against a window of
+// MAX_PATTERN_WORDS words of the SearchEngine, longest match first: "/al.*/"
+// covers the whole window, "/al\S*/" a single word. Negated classes, "\D",
+// "\W" and "\S" never match a space.
+//
+// Pattern length, nesting and both automatons are limited in size, so a bad
+// pattern fails to compile instead of hanging the search. Matching is
+// linear in the length of the text.
+//------------------------------------------------------------------------
+class PatternMatcher
+{
+public:
+    //--------------------------------------------------------------------
+    using StringView        = std::string_view;
+    using PatternMatcherPtr = std::shared_ptr<const PatternMatcher>;
+    using OptLength         = std::optional<size_t>;
+
+    static constexpr size_t MAX_PATTERN_LENGTH = 256;
+    static constexpr size_t MAX_NESTING        = 32;
+    static constexpr size_t MAX_REPETITIONS    = 16;
+    static constexpr size_t MAX_NFA_STATES     = 4096;
+    static constexpr size_t MAX_DFA_STATES     = 1024;
+
+    /** Raw query as typed, see is_pattern() */
+    static auto is_pattern(StringView query) -> bool;
+
+    /** Nullptr for plain queries and patterns which fail to compile */
+    static auto create(StringView query) -> PatternMatcherPtr;
+
+    /** The pattern can match a space, so hits can span several words */
+    auto spans_words() const -> bool { return is_multi_word; }
+
+    /** The whole text matches */
+    auto is_match(StringView text) const -> bool;
+
+    /** Longest non empty match at the start of the space separated words,
+     *  which ends at the end of a word
+     */
+    auto longest_match(StringView words) const -> OptLength;
+
+    //--------------------------------------------------------------------
+private:
+    using State       = uint16_t;
+    using Transitions = std::vector<State>;
+
+    static constexpr State DEAD_STATE  = 0;
+    static constexpr State START_STATE = 1;
+
+    PatternMatcher() = default;
+
+    static auto compile(StringView regex) -> PatternMatcherPtr;
+
+    auto next(State state, char c) const -> State
+    {
+        return transitions[state * 256 + static_cast<unsigned char>(c)];
+    }
+
+    Transitions transitions; // 256 per state
+    std::vector<bool> accepting;
+    bool is_multi_word = false;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
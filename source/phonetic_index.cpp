@@ -0,0 +1,67 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "phonetic_index.h"
+#include <algorithm>
+#include <iterator>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// PhoneticIndex
+//------------------------------------------------------------------------
+auto PhoneticIndex::add(TermId term_id, StringView term) -> void
+{
+    const auto keys = double_metaphone::encode(term);
+    for (const auto* key : {&keys.primary, &keys.alternate})
+    {
+        if (key->empty())
+            continue;
+
+        // Primary and alternate key are often the same
+        auto& term_ids = postings[*key];
+        if (term_ids.empty() || term_ids.back() != term_id)
+            term_ids.push_back(term_id);
+    }
+}
+
+//------------------------------------------------------------------------
+auto PhoneticIndex::find(const Keys& keys) const -> TermIds
+{
+    const auto lookup = [this](const StringType& key) -> const TermIds* {
+        const auto iter = postings.find(key);
+        return iter != postings.end() ? &iter->second : nullptr;
+    };
+
+    const auto* primary = lookup(keys.primary);
+    const auto* alternate =
+        keys.alternate != keys.primary ? lookup(keys.alternate) : nullptr;
+    if (!primary || !alternate)
+    {
+        if (primary)
+            return *primary;
+
+        return alternate ? *alternate : TermIds{};
+    }
+
+    TermIds result;
+    std::set_union(primary->begin(), primary->end(), alternate->begin(),
+                   alternate->end(), std::back_inserter(result));
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto PhoneticIndex::memory_usage() const -> size_t
+{
+    size_t bytes = sizeof(PhoneticIndex);
+    for (const auto& entry : postings)
+        bytes += sizeof(entry) + sizeof(void*) + entry.first.capacity() +
+                 entry.second.capacity() * sizeof(TermId);
+
+    bytes += postings.bucket_count() * sizeof(void*);
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,47 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "double_metaphone.h"
+#include "wordify_types.h"
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// PhoneticIndex
+//
+// Maps the Double Metaphone keys of the vocabulary terms to the ascending
+// ids of the terms sounding like them. Keys are computed once when a term
+// is added. The keys of a query are encoded once by the caller, so looking
+// them up in several indices costs two hash lookups each.
+//------------------------------------------------------------------------
+class PhoneticIndex
+{
+public:
+    //--------------------------------------------------------------------
+    using TermId     = uint32_t;
+    using TermIds    = std::vector<TermId>;
+    using StringView = std::string_view;
+    using Keys       = double_metaphone::Keys;
+
+    /** Terms must be added with ascending ids */
+    auto add(TermId term_id, StringView term) -> void;
+
+    /** All terms sharing a key with the query, ascending. The keys are
+     *  the ones of double_metaphone::encode(query) */
+    auto find(const Keys& keys) const -> TermIds;
+    auto memory_usage() const -> size_t;
+
+    //--------------------------------------------------------------------
+private:
+    using Postings = std::unordered_map<StringType, TermIds>;
+
+    Postings postings;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,71 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include <atomic>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// Playhead
+//
+// Single writer slot for the host's playhead. The audio thread publishes
+// the project time once per process call, the UI thread samples it on a
+// timer. Both sides are wait free, no locks and no allocations involved.
+//
+// Several plug-in instances can be bound to the same document controller
+// and all of them see the same playhead. The first one to publish becomes
+// the writer, the others are ignored until it releases the slot.
+//------------------------------------------------------------------------
+class Playhead
+{
+public:
+    //--------------------------------------------------------------------
+    using Seconds = double;
+    using Writer  = const void*;
+
+    struct State
+    {
+        Seconds time    = 0.;
+        bool is_playing = false;
+    };
+
+    /** Audio thread only */
+    auto publish(Writer writer_, Seconds time_, bool is_playing_) -> void
+    {
+        Writer expected = nullptr;
+        if (!writer.compare_exchange_strong(expected, writer_) &&
+            expected != writer_)
+            return;
+
+        time.store(time_, std::memory_order_relaxed);
+        is_playing.store(is_playing_, std::memory_order_release);
+    }
+
+    /** Lets the next instance publishing take over, e.g. once the writer
+     *  is deactivated */
+    auto release(Writer writer_) -> void
+    {
+        writer.compare_exchange_strong(writer_, nullptr);
+    }
+
+    /** Any thread. Time and playing state are not read as one unit, which is
+     *  fine as the next sample will catch up anyway. */
+    auto read() const -> State
+    {
+        const auto playing = is_playing.load(std::memory_order_acquire);
+        return {time.load(std::memory_order_relaxed), playing};
+    }
+
+    //--------------------------------------------------------------------
+private:
+    static_assert(std::atomic<Seconds>::is_always_lock_free,
+                  "Playhead must be lock free on the audio thread");
+
+    std::atomic<Writer> writer{nullptr};
+    std::atomic<Seconds> time{0.};
+    std::atomic<bool> is_playing{false};
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -13,13 +13,17 @@ namespace mam::meta_words::serde {
 using json                                  = nlohmann::json;
 static constexpr auto PREFERENCES_FILE_NAME = "preferences.json";
 
-static constexpr auto PREFS_VERSION_KEY       = "preferences_version";
-static constexpr auto COLOR_SCHEME_KEY        = "color_scheme";
-static constexpr auto COLOR_SCHEME_LITE_VALUE = "light";
-static constexpr auto COLOR_SCHEME_DARK_VALUE = "dark";
-static constexpr auto SMART_SEARCH_KEY        = "smart_search";
-static constexpr auto SMART_SEARCH_OFF_VALUE  = "off";
-static constexpr auto SMART_SEARCH_ON_VALUE   = "on";
+static constexpr auto PREFS_VERSION_KEY              = "preferences_version";
+static constexpr auto COLOR_SCHEME_KEY               = "color_scheme";
+static constexpr auto COLOR_SCHEME_LITE_VALUE        = "light";
+static constexpr auto COLOR_SCHEME_DARK_VALUE        = "dark";
+static constexpr auto SMART_SEARCH_KEY               = "smart_search";
+static constexpr auto SMART_SEARCH_OFF_VALUE         = "off";
+static constexpr auto SMART_SEARCH_ON_VALUE          = "on";
+static constexpr auto SMART_SEARCH_METHOD_KEY        = "smart_search_method";
+static constexpr auto SMART_SEARCH_FUZZY_VALUE       = "fuzzy";
+static constexpr auto SMART_SEARCH_SOUNDS_LIKE_VALUE = "sounds_like";
+static constexpr auto SMART_SEARCH_STEMMED_VALUE     = "stemmed";
 //------------------------------------------------------------------------
 NLOHMANN_JSON_SERIALIZE_ENUM(ColorScheme,
                              {
@@ -33,12 +37,20 @@ NLOHMANN_JSON_SERIALIZE_ENUM(SmartSearch,
                                  {On, SMART_SEARCH_ON_VALUE},
                              })
 
+NLOHMANN_JSON_SERIALIZE_ENUM(SmartSearchMethod,
+                             {
+                                 {Fuzzy, SMART_SEARCH_FUZZY_VALUE},
+                                 {SoundsLike, SMART_SEARCH_SOUNDS_LIKE_VALUE},
+                                 {Stemmed, SMART_SEARCH_STEMMED_VALUE},
+                             })
+
 //------------------------------------------------------------------------
 void to_json(json& j, const Preferences& prefs)
 {
     j = json{{PREFS_VERSION_KEY, prefs.version},
              {COLOR_SCHEME_KEY, prefs.color_scheme},
-             {SMART_SEARCH_KEY, prefs.smart_search}};
+             {SMART_SEARCH_KEY, prefs.smart_search},
+             {SMART_SEARCH_METHOD_KEY, prefs.smart_search_method}};
 }
 
 //------------------------------------------------------------------------
@@ -49,6 +61,8 @@ void from_json(const json& j, Preferences& prefs)
         j.at(COLOR_SCHEME_KEY).get_to(prefs.color_scheme);
     if (j.contains(SMART_SEARCH_KEY))
         j.at(SMART_SEARCH_KEY).get_to(prefs.smart_search);
+    if (j.contains(SMART_SEARCH_METHOD_KEY))
+        j.at(SMART_SEARCH_METHOD_KEY).get_to(prefs.smart_search_method);
 }
 
 //------------------------------------------------------------------------
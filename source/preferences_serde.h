@@ -24,11 +24,19 @@ enum SmartSearch
     On
 };
 
+enum SmartSearchMethod
+{
+    Fuzzy,
+    SoundsLike,
+    Stemmed
+};
+
 struct Preferences
 {
     size_t version = 1;
     ColorScheme color_scheme{Dark};
     SmartSearch smart_search{Off};
+    SmartSearchMethod smart_search_method{Fuzzy};
 };
 
 //------------------------------------------------------------------------
@@ -0,0 +1,156 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "query_refiner.h"
+#include <algorithm>
+#include <iterator>
+
+namespace mam {
+namespace {
+
+//------------------------------------------------------------------------
+using MatchMethod = QueryRefiner::MatchMethod;
+using StringView  = QueryRefiner::StringView;
+using TermIds     = QueryRefiner::TermIds;
+
+//------------------------------------------------------------------------
+auto contains(StringView term, StringView query) -> bool
+{
+    return term.find(query) != StringView::npos;
+}
+
+//------------------------------------------------------------------------
+auto find_all_terms(const Vocabulary& vocabulary,
+                    StringView query,
+                    MatchMethod method) -> TermIds
+{
+    switch (method)
+    {
+        case MatchMethod::directMatch: {
+            if (const auto term = vocabulary.find(query))
+                return {*term};
+
+            return {};
+        }
+        case MatchMethod::subMatch:
+            return vocabulary.find_containing(query);
+        case MatchMethod::phoneticMatch:
+            return vocabulary.find_sounding_like(query);
+        case MatchMethod::stemMatch:
+            return vocabulary.find_same_stem(query);
+        default:
+            break;
+    }
+
+    if (const auto max_distance = StringMatcher::maxEditDistance(method))
+        return vocabulary.find_similar(query, *max_distance);
+
+    return {};
+}
+
+//------------------------------------------------------------------------
+template <typename Predicate>
+auto filter(const TermIds& term_ids, Predicate&& predicate) -> TermIds
+{
+    TermIds result;
+    std::copy_if(term_ids.begin(), term_ids.end(), std::back_inserter(result),
+                 predicate);
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// QueryRefiner
+//------------------------------------------------------------------------
+auto QueryRefiner::find_terms(const SearchIndex::Snapshot& snapshot,
+                              StringView query,
+                              MatchMethod method) -> TermIds
+{
+    if (snapshot.generation != generation)
+    {
+        clear();
+        generation = snapshot.generation;
+    }
+
+    // Same query again e.g. after a backspace
+    auto iter = find_entry(query, method);
+    if (iter != entries.end())
+    {
+        entries.splice(entries.begin(), entries, iter);
+        stats.count_cache_hits++;
+        return entries.front().matches;
+    }
+
+    const auto& vocabulary = *snapshot.vocabulary;
+
+    Entry entry{StringType(query), method, {}};
+
+    iter = find_longest_prefix(query, method);
+    if (iter == entries.end())
+    {
+        entry.matches = find_all_terms(vocabulary, query, method);
+        stats.count_full_queries++;
+        return insert(std::move(entry)).matches;
+    }
+
+    entry.matches = filter(iter->matches, [&](TermId term_id) {
+        return contains(vocabulary.term(term_id), query);
+    });
+
+    stats.count_refinements++;
+    return insert(std::move(entry)).matches;
+}
+
+//------------------------------------------------------------------------
+auto QueryRefiner::clear() -> void
+{
+    entries.clear();
+}
+
+//------------------------------------------------------------------------
+auto QueryRefiner::find_entry(StringView query, MatchMethod method)
+    -> Entries::iterator
+{
+    return std::find_if(entries.begin(), entries.end(), [&](const auto& e) {
+        return e.method == method && e.query == query;
+    });
+}
+
+//------------------------------------------------------------------------
+auto QueryRefiner::find_longest_prefix(StringView query, MatchMethod method)
+    -> Entries::iterator
+{
+    // Only substring matches can be refined, see QueryRefiner
+    if (method != MatchMethod::subMatch)
+        return entries.end();
+
+    auto best = entries.end();
+    for (auto iter = entries.begin(); iter != entries.end(); ++iter)
+    {
+        if (iter->method != method || iter->query.size() >= query.size())
+            continue;
+
+        if (query.substr(0, iter->query.size()) != iter->query)
+            continue;
+
+        if (best == entries.end() || iter->query.size() > best->query.size())
+            best = iter;
+    }
+
+    return best;
+}
+
+//------------------------------------------------------------------------
+auto QueryRefiner::insert(Entry&& entry) -> const Entry&
+{
+    entries.push_front(std::move(entry));
+    if (entries.size() > CAPACITY)
+        entries.pop_back();
+
+    return entries.front();
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,79 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "search_index.h"
+#include "string_matcher.h"
+#include "wordify_types.h"
+#include <list>
+#include <string_view>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// QueryRefiner
+//
+// Finds the vocabulary terms matching a normalized query for search as you
+// type. Substring matches are monotone under query extension: a term
+// containing "abc" always contains "ab" as well. When a substring query
+// extends one of the most recent ones, only the terms found for that one are
+// filtered instead of querying the whole vocabulary.
+//
+// All other methods are answered by the vocabulary's own indices, which
+// beats any filtering: exact matches are one hash lookup, fuzzy matches go
+// through the BK-tree, sounds-like and stemmed ones through their keys.
+// Their results are cached but never refined.
+//
+// Shrinking queries (backspace) are usually still in the cache. A cache
+// entry is only valid for the generation of the SearchIndex it was created
+// with.
+//------------------------------------------------------------------------
+class QueryRefiner
+{
+public:
+    //--------------------------------------------------------------------
+    using TermId      = Vocabulary::TermId;
+    using TermIds     = Vocabulary::TermIds;
+    using Generation  = SearchIndex::Generation;
+    using MatchMethod = StringMatcher::MatchMethod;
+    using StringView  = std::string_view;
+
+    static constexpr size_t CAPACITY = 8;
+
+    struct Stats
+    {
+        size_t count_full_queries = 0;
+        size_t count_refinements  = 0;
+        size_t count_cache_hits   = 0;
+    };
+
+    /** Terms matching the normalized query, ascending */
+    auto find_terms(const SearchIndex::Snapshot& snapshot,
+                    StringView query,
+                    MatchMethod method) -> TermIds;
+    auto clear() -> void;
+    auto get_stats() const -> const Stats& { return stats; }
+
+    //--------------------------------------------------------------------
+private:
+    struct Entry
+    {
+        StringType query;
+        MatchMethod method = MatchMethod::directMatch;
+        TermIds matches;
+    };
+
+    using Entries = std::list<Entry>;
+
+    auto find_entry(StringView query, MatchMethod method) -> Entries::iterator;
+    auto find_longest_prefix(StringView query, MatchMethod method)
+        -> Entries::iterator;
+    auto insert(Entry&& entry) -> const Entry&;
+
+    Entries entries; // Most recently used first
+    Generation generation = 0;
+    Stats stats;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
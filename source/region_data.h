@@ -3,6 +3,7 @@
 #pragma once
 
 #include "mam/meta_words/meta_word.h"
+#include "word_store.h"
 #include "wordify_types.h"
 #include <tuple>
 #include <utility>
@@ -11,14 +12,80 @@
 namespace mam {
 
 //------------------------------------------------------------------------
-struct RegionWordData
+// RegionWords
+//
+// View onto the shared WordStore of the region's audio source. Word indices
+// are always indices into the store, but only the ones inside the region's
+// window [first, last) are visible.
+//------------------------------------------------------------------------
+class RegionWords
 {
-    bool is_clipped_by_region = true;
-    bool is_punctuation_mark  = false;
-    meta_words::MetaWord word;
-};
+public:
+    //--------------------------------------------------------------------
+    using Seconds      = double;
+    using Millis       = meta_words::WordStore::Millis;
+    using TermId       = meta_words::WordStore::TermId;
+    using StringView   = meta_words::WordStore::StringView;
+    using WordStorePtr = meta_words::WordStorePtr;
+    using WordWindow   = meta_words::WordWindow;
+
+    RegionWords() = default;
+    RegionWords(const WordStorePtr& store, Seconds start, Seconds end)
+    : store(store)
+    , start_ms(meta_words::WordStore::to_millis(start))
+    , end_ms(meta_words::WordStore::to_millis(end))
+    {
+        if (store)
+            window = store->find_window(start, end);
+    }
+
+    /** False as long as the audio source has not been analysed yet */
+    auto is_valid() const -> bool { return store != nullptr; }
+    auto get_store() const -> const WordStorePtr& { return store; }
+    auto get_window() const -> const WordWindow& { return window; }
+    auto first() const -> Index { return window.first; }
+    auto last() const -> Index { return window.last; }
+    auto size() const -> Index { return window.size(); }
+    auto empty() const -> bool { return window.empty(); }
+    auto contains(Index index) const -> bool { return window.contains(index); }
 
-using RegionWordDataset = std::vector<RegionWordData>;
+    auto begin(Index index) const -> Seconds { return store->begin(index); }
+    auto duration(Index index) const -> Seconds
+    {
+        return store->duration(index);
+    }
+    auto term(Index index) const -> TermId { return store->term(index); }
+    auto text(Index index) const -> StringView { return store->text(index); }
+    auto normalized(Index index) const -> StringView
+    {
+        return store->normalized(index);
+    }
+    auto is_punctuation_mark(Index index) const -> bool
+    {
+        return store->is_punctuation_mark(index);
+    }
+
+    /** Clipping depends on the region, so it is not stored per word but
+     *  derived from the window and the region's time range.
+     */
+    auto is_clipped_by_region(Index index) const -> bool
+    {
+        if (!contains(index))
+            return true;
+
+        const auto begin    = store->begin_ms(index);
+        const auto word_end = begin + store->duration_ms(index);
+        return !((begin >= start_ms && begin < end_ms) ||
+                 (word_end >= start_ms && word_end < end_ms));
+    }
+
+    //--------------------------------------------------------------------
+private:
+    WordStorePtr store;
+    WordWindow window;
+    Millis start_ms = 0;
+    Millis end_ms   = 0;
+};
 
 //------------------------------------------------------------------------
 struct RegionData
@@ -31,7 +98,7 @@ struct RegionData
     Seconds project_offset{0.};
     Seconds project_time_start{0.};
     Seconds duration{0.};
-    RegionWordDataset words;
+    RegionWords words;
 };
 
 //------------------------------------------------------------------------
@@ -2,176 +2,406 @@
 
 #include "search_engine.h"
 #include "meta_words_playback_region.h"
+#include "text_normalizer.h"
 #include "wordify_types.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <utility>
 
 namespace mam {
 namespace {
 //------------------------------------------------------------------------
-auto collect_search_results(const StringType& search_word,
-                            const SearchEngine::Regions& regions,
-                            SearchEngine::MatchFunc&& match_func)
-    -> const SearchEngine::SearchResults
-{
-    SearchEngine::SearchResults results;
+using StringView = std::string_view;
 
-    for (const auto& region : regions)
+//------------------------------------------------------------------------
+auto scan_region_words(const RegionWords& words,
+                       StringView query,
+                       const SearchEngine::MatchFunc& match_func)
+    -> SearchEngine::WordIndices
+{
+    SearchEngine::WordIndices indices;
+    for (auto i = words.first(); i < words.last(); i++)
     {
-        auto region_data = region.second->get_region_data();
+        if (words.is_clipped_by_region(i))
+            continue;
+
+        // Punctuation marks normalize to nothing, they are never found
+        const auto normalized = words.normalized(i);
+        if (normalized.empty())
+            continue;
 
-        SearchEngine::WordIndices indices;
-        for (size_t i = 0; i < region_data.words.size(); i++)
+        if (match_func(normalized, query))
+            indices.push_back(i);
+    }
+
+    return indices;
+}
+
+//------------------------------------------------------------------------
+auto lookup_region_words(const RegionWords& words,
+                         const SourceIndex& source_index,
+                         const Vocabulary::TermIds& terms)
+    -> SearchEngine::WordIndices
+{
+    SearchEngine::WordIndices indices;
+    for (const auto term : terms)
+    {
+        // Postings are ascending, so the region's share is one contiguous run
+        const auto postings = source_index.postings(term);
+        auto iter =
+            std::lower_bound(postings.begin(), postings.end(), words.first());
+        for (; iter != postings.end() && *iter < words.last(); ++iter)
         {
-            const auto& word_data = region_data.words[i];
-            if (word_data.is_clipped_by_region)
+            if (words.is_clipped_by_region(*iter))
                 continue;
 
-            auto word = word_data.word.value;
-            if (match_func(word, search_word))
-                indices.push_back(i);
+            indices.push_back(*iter);
         }
-
-        if (!indices.empty())
-            results.push_back({region.first, indices, std::nullopt});
     }
 
-    return results;
+    if (terms.size() > 1)
+        std::sort(indices.begin(), indices.end());
+
+    return indices;
 }
 
 //------------------------------------------------------------------------
-} // namespace
+struct PhraseHits
+{
+    SearchEngine::WordIndices indices;
+    SearchEngine::WordIndices ends;
+
+    auto add(Index first, Index last) -> void
+    {
+        indices.push_back(first);
+        ends.push_back(last + 1);
+    }
+};
+
+using Tokens     = std::vector<StringView>;
+
+// Words a single hit of a pattern can span at most
+constexpr size_t MAX_PATTERN_WORDS = 8;
+
+using TokenTerms = std::vector<Vocabulary::TermIds>;
 
 //------------------------------------------------------------------------
-struct SearchEngineCache
+auto split_words(StringView query) -> Tokens
 {
-    struct RegionWord
-    {
-        SearchEngine::RegionID region_id   = 0;
-        SearchEngine::WordIndex word_index = 0;
+    const auto is_space = [](char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
     };
 
-    static SearchEngineCache& instance()
+    Tokens tokens;
+    size_t pos = 0;
+    while (pos < query.size())
     {
-        static SearchEngineCache cache;
-        return cache;
+        while (pos < query.size() && is_space(query[pos]))
+            pos++;
+
+        const auto begin = pos;
+        while (pos < query.size() && !is_space(query[pos]))
+            pos++;
+
+        if (pos > begin)
+            tokens.push_back(query.substr(begin, pos - begin));
     }
 
-    SearchEngine::SearchResults search_results;
-    StringType search_word;
-    RegionWord focused_word;
-};
+    return tokens;
+}
 
-namespace detail {
 //------------------------------------------------------------------------
-auto search(const StringType& search_word,
-            const SearchEngine::Regions& regions,
-            SearchEngine::MatchFunc&& match_func)
-    -> const SearchEngine::SearchResults&
+auto scan_region_phrase(const RegionWords& words,
+                        const Tokens& tokens,
+                        const SearchEngine::MatchFunc& match_func)
+    -> PhraseHits
 {
-    if (SearchEngineCache::instance().search_word == search_word)
-        return SearchEngineCache::instance().search_results;
-
-    SearchEngineCache::instance().search_word = search_word;
-    SearchEngineCache::instance().search_results =
-        collect_search_results(search_word, regions, std::move(match_func));
+    // Punctuation marks normalize to nothing and are skipped
+    const auto next_word = [&](Index i) {
+        while (i < words.last() && words.normalized(i).empty())
+            i++;
+        return i;
+    };
 
-    // Focus the first word
-    if (!SearchEngineCache::instance().search_results.empty())
+    PhraseHits hits;
+    for (auto first = next_word(words.first()); first < words.last();
+         first      = next_word(first + 1))
     {
-        auto& first_result = SearchEngineCache::instance().search_results.at(0);
+        auto word      = first;
+        size_t matched = 0;
+        while (!words.is_clipped_by_region(word) &&
+               match_func(words.normalized(word), tokens[matched]))
+        {
+            if (++matched == tokens.size())
+                break;
+
+            word = next_word(word + 1);
+            if (word >= words.last())
+                break;
+        }
 
-        constexpr auto DEFAULT_WORD_INDEX          = 0;
-        first_result.focused_word                  = DEFAULT_WORD_INDEX;
-        SearchEngineCache::instance().focused_word = {
-            first_result.region_id, first_result.focused_word.value()};
+        if (matched == tokens.size())
+            hits.add(first, word);
     }
 
-    return SearchEngineCache::instance().search_results;
+    return hits;
 }
 
 //------------------------------------------------------------------------
-auto next_occurence() -> SearchEngine::SearchResults
+auto lookup_region_phrase(const RegionWords& words,
+                          const SourceIndex& source_index,
+                          const TokenTerms& token_terms) -> PhraseHits
 {
-    auto& focused_word   = SearchEngineCache::instance().focused_word;
-    auto& search_results = SearchEngineCache::instance().search_results;
+    // Punctuation marks have no term and are skipped
+    const auto is_word = [&](Index i) {
+        return source_index.term(i) != Vocabulary::INVALID_TERM;
+    };
+    const auto next_word = [&](Index i) -> std::optional<Index> {
+        for (i++; i < words.last(); i++)
+        {
+            if (is_word(i))
+                return i;
+        }
+        return std::nullopt;
+    };
+    const auto prev_word = [&](Index i) -> std::optional<Index> {
+        while (i > words.first())
+        {
+            if (is_word(--i))
+                return i;
+        }
+        return std::nullopt;
+    };
+    const auto matches = [&](std::optional<Index> i, size_t token) {
+        const auto& terms = token_terms[token];
+        return i && !words.is_clipped_by_region(*i) &&
+               std::binary_search(terms.begin(), terms.end(),
+                                  source_index.term(*i));
+    };
 
-    SearchEngine::SearchResults results;
+    // Anchor on the rarest word of the phrase and verify its neighbours,
+    // that is far cheaper than intersecting all postings lists
+    size_t anchor    = 0;
+    size_t min_count = std::numeric_limits<size_t>::max();
+    for (size_t token = 0; token < token_terms.size(); token++)
+    {
+        size_t count = 0;
+        for (const auto term : token_terms[token])
+            count += source_index.postings(term).size();
 
-    auto iter = std::find_if(
-        search_results.begin(), search_results.end(), [&](const auto& result) {
-            return result.region_id == focused_word.region_id;
-        });
+        if (count < min_count)
+        {
+            anchor    = token;
+            min_count = count;
+        }
+    }
 
-    if (iter == search_results.end())
-        return results; // Should not happen, would be a serious error!
+    std::vector<std::pair<Index, Index>> ranges;
+    for (const auto term : token_terms[anchor])
+    {
+        const auto postings = source_index.postings(term);
+        auto iter =
+            std::lower_bound(postings.begin(), postings.end(), words.first());
+        for (; iter != postings.end() && *iter < words.last(); ++iter)
+        {
+            std::optional<Index> first = *iter;
+            bool is_match              = matches(first, anchor);
+            for (auto token = anchor; is_match && token > 0; token--)
+            {
+                first    = prev_word(*first);
+                is_match = matches(first, token - 1);
+            }
+
+            std::optional<Index> last = *iter;
+            for (auto token = anchor + 1;
+                 is_match && token < token_terms.size(); token++)
+            {
+                last     = next_word(*last);
+                is_match = matches(last, token);
+            }
+
+            if (is_match)
+                ranges.emplace_back(*first, *last);
+        }
+    }
+
+    if (token_terms[anchor].size() > 1)
+        std::sort(ranges.begin(), ranges.end());
 
-    focused_word.word_index++;
-    if (focused_word.word_index < iter->indices.size())
+    PhraseHits hits;
+    for (const auto& range : ranges)
+        hits.add(range.first, range.second);
+
+    return hits;
+}
+
+//------------------------------------------------------------------------
+auto scan_region_pattern(const RegionWords& words,
+                         const PatternMatcher& pattern) -> PhraseHits
+{
+    // Normalized words of the region, separated by single spaces
+    StringType text;
+    std::vector<size_t> starts;
+    SearchEngine::WordIndices word_indices;
+    for (auto i = words.first(); i < words.last(); i++)
     {
-        // Still in the same region
-        iter->focused_word = focused_word.word_index;
-        results.push_back(*iter);
+        const auto normalized = words.normalized(i);
+        if (words.is_clipped_by_region(i) || normalized.empty())
+            continue;
+
+        if (!text.empty())
+            text.push_back(' ');
+
+        starts.push_back(text.size());
+        word_indices.push_back(i);
+        text += normalized;
     }
-    else
+
+    // Leftmost longest matches, limited to MAX_PATTERN_WORDS each
+    PhraseHits hits;
+    for (size_t first = 0; first < starts.size();)
     {
-        // Advance from one region to the next
-        iter->focused_word.reset();
-        results.push_back(*iter);
+        const auto end_word =
+            std::min(first + MAX_PATTERN_WORDS, starts.size());
+        const auto end =
+            end_word < starts.size() ? starts[end_word] - 1 : text.size();
+        const auto length = pattern.longest_match(
+            StringView(text).substr(starts[first], end - starts[first]));
+        if (!length)
+        {
+            first++;
+            continue;
+        }
 
-        iter = std::next(iter);
-        if (iter == search_results.end())
-            iter = search_results.begin();
+        const auto match_end = starts[first] + *length;
+        const auto last =
+            static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(),
+                                                 match_end - 1) -
+                                starts.begin()) -
+            1;
 
-        focused_word.word_index = 0;
-        focused_word.region_id  = iter->region_id;
-        iter->focused_word      = focused_word.word_index;
-        results.push_back(*iter);
+        hits.add(word_indices[first], word_indices[last]);
+        first = last + 1;
     }
 
-    return results;
+    return hits;
 }
 
 //------------------------------------------------------------------------
-auto prev_occurence() -> SearchEngine::SearchResults
+template <typename Regions, typename RegionSnapshots>
+auto take_snapshot(const Regions& regions, RegionSnapshots& snapshots) -> void
 {
-    auto& focused_word   = SearchEngineCache::instance().focused_word;
-    auto& search_results = SearchEngineCache::instance().search_results;
+    using Region = typename Regions::value_type;
+    std::vector<const Region*> sorted;
+    sorted.reserve(regions.size());
+    for (const auto& region : regions)
+        sorted.push_back(&region);
 
-    SearchEngine::SearchResults results;
+    // Timeline order, so hits are found and focused from left to right.
+    // Regions starting at the same time stay in the order of their ids.
+    std::stable_sort(sorted.begin(), sorted.end(), [](auto* lhs, auto* rhs) {
+        return lhs->second->getStartInPlaybackTime() <
+               rhs->second->getStartInPlaybackTime();
+    });
 
-    auto iter =
-        std::find_if(search_results.rbegin(), search_results.rend(),
-                     [&](const auto& result) {
-                         return result.region_id == focused_word.region_id;
-                     });
+    snapshots.reserve(sorted.size());
+    for (const auto* region : sorted)
+    {
+        snapshots.push_back({region->first,
+                             region->second->get_audio_source_id(),
+                             region->second->get_region_words()});
+    }
+}
+
+//------------------------------------------------------------------------
+constexpr size_t MAX_SCAN_THREADS   = 16;
+constexpr size_t MIN_PARALLEL_SCANS = 8;
 
-    if (iter == search_results.rend())
-        return results; // Should not happen, would be a serious error!
+auto count_scan_threads() -> size_t
+{
+    // Leave one core to the UI and the audio threads
+    const size_t cores = std::thread::hardware_concurrency();
+    return std::clamp<size_t>(cores > 1 ? cores - 1 : 1, 1, MAX_SCAN_THREADS);
+}
+
+//------------------------------------------------------------------------
+} // namespace
 
-    if (focused_word.word_index == 0)
+//------------------------------------------------------------------------
+struct SearchEngineCache
+{
+    // Flat list entry, the result and the hit within its indices
+    struct Hit
     {
-        // Advance from one region to the next
-        iter->focused_word.reset();
-        results.push_back(*iter);
+        size_t result = 0;
+        size_t hit    = 0;
+    };
 
-        iter = std::next(iter);
-        if (iter == search_results.rend())
-            iter = search_results.rbegin();
+    using Hits = std::vector<Hit>;
 
-        focused_word.word_index = iter->indices.size() - 1;
-        focused_word.region_id  = iter->region_id;
-        iter->focused_word      = focused_word.word_index;
-        results.push_back(*iter);
-    }
-    else
+    static SearchEngineCache& instance()
     {
-        focused_word.word_index--;
+        static SearchEngineCache cache;
+        return cache;
+    }
 
-        // Still in the same region
-        iter->focused_word = focused_word.word_index;
-        results.push_back(*iter);
+    auto to_occurence(size_t n) const -> SearchEngine::Occurence
+    {
+        const auto& result = search_results[hits[n].result];
+        return {result.region_id, result.indices[hits[n].hit],
+                result.hit_end(hits[n].hit)};
     }
 
-    return results;
+    SearchEngine::SearchResults search_results;
+    StringType search_word;
+    Hits hits; // All hits in timeline order
+    size_t focused_hit = 0;
+};
+
+namespace detail {
+//------------------------------------------------------------------------
+auto focus_occurence(size_t n) -> SearchEngine::FocusChange
+{
+    auto& cache = SearchEngineCache::instance();
+    if (n >= cache.hits.size())
+        return {};
+
+    const auto& prev_hit = cache.hits[cache.focused_hit];
+    const auto& hit      = cache.hits[n];
+    cache.search_results[prev_hit.result].focused_word.reset();
+    cache.search_results[hit.result].focused_word = hit.hit;
+
+    SearchEngine::FocusChange change{cache.to_occurence(cache.focused_hit),
+                                     cache.to_occurence(n)};
+    cache.focused_hit = n;
+
+    return change;
+}
+
+//------------------------------------------------------------------------
+auto next_occurence() -> SearchEngine::FocusChange
+{
+    const auto& cache = SearchEngineCache::instance();
+    if (cache.hits.empty())
+        return {};
+
+    // Wraps around at the end
+    return focus_occurence((cache.focused_hit + 1) % cache.hits.size());
+}
+
+//------------------------------------------------------------------------
+auto prev_occurence() -> SearchEngine::FocusChange
+{
+    const auto& cache = SearchEngineCache::instance();
+    if (cache.hits.empty())
+        return {};
+
+    // Wraps around at the beginning
+    const auto count = cache.hits.size();
+    return focus_occurence((cache.focused_hit + count - 1) % count);
 }
 
 //------------------------------------------------------------------------
@@ -182,31 +412,94 @@ auto clear_results() -> SearchEngine::SearchResults
     {
         result.focused_word = std::nullopt;
         result.indices.clear();
+        result.ends.clear();
     }
 
     SearchEngineCache::instance().search_results.clear();
     SearchEngineCache::instance().search_word.clear();
+    SearchEngineCache::instance().hits.clear();
+    SearchEngineCache::instance().focused_hit = 0;
 
     return results;
 }
 //------------------------------------------------------------------------
 } // namespace detail
 
+//------------------------------------------------------------------------
+// SearchEngine::SearchResult
+//------------------------------------------------------------------------
+auto SearchEngine::SearchResult::find_hit(WordIndex word_index) const
+    -> OptWord
+{
+    // Last hit starting at or before the word
+    const auto iter =
+        std::upper_bound(indices.begin(), indices.end(), word_index);
+    if (iter == indices.begin())
+        return std::nullopt;
+
+    const auto hit = static_cast<size_t>(iter - indices.begin()) - 1;
+    if (word_index >= hit_end(hit))
+        return std::nullopt;
+
+    return hit;
+}
+
 //------------------------------------------------------------------------
 // SearchEngine
+//------------------------------------------------------------------------
+SearchEngine::~SearchEngine()
+{
+    count_worker_users = 0;
+    join_worker();
+}
+
 //------------------------------------------------------------------------
 auto SearchEngine::search(const StringType& search_word,
                           MatchFunc&& match_func) -> void
 {
     if (!get_regions)
         return;
-    
+
+    this->clear_results();
+
+    auto request       = create_request(search_word);
+    request.match_func = std::move(match_func);
+    post(std::move(request));
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::search(const StringType& search_word, MatchMethod method)
+    -> void
+{
+    if (!get_regions)
+        return;
+
     this->clear_results();
 
-    const auto& results =
-        detail::search(search_word, get_regions(), std::move(match_func));
+    auto request   = create_request(search_word);
+    request.method = method;
+    if (get_search_index)
+        request.index = get_search_index();
 
-    callback(results);
+    // Stemmed like the index, so scanned regions get the same hits
+    auto stemmer = request.index ? request.index->vocabulary->get_stemmer()
+                                 : Vocabulary::StemmerPtr{};
+    request.match_func = [method, stemmer](StringView word, StringView query) {
+        return StringMatcher::isMatch(word, query, method, stemmer.get());
+    };
+
+    // Regular expressions and wildcards replace the match method
+    request.is_pattern = PatternMatcher::is_pattern(search_word);
+    if (request.is_pattern)
+    {
+        request.pattern    = PatternMatcher::create(search_word);
+        request.match_func = [pattern = request.pattern](StringView word,
+                                                         StringView) {
+            return pattern && pattern->is_match(word);
+        };
+    }
+
+    post(std::move(request));
 }
 
 //------------------------------------------------------------------------
@@ -217,23 +510,50 @@ auto SearchEngine::research(MatchFunc&& match_func) -> void
     return search(w, std::move(match_func));
 }
 
+//------------------------------------------------------------------------
+auto SearchEngine::research(MatchMethod method) -> void
+{
+    const auto w = SearchEngineCache::instance().search_word;
+    clear_results();
+    return search(w, method);
+}
+
 //------------------------------------------------------------------------
 auto SearchEngine::next_occurence() -> void
 {
-    const auto results = mam::detail::next_occurence();
-    callback(results);
+    const auto change = mam::detail::next_occurence();
+    if (change.current)
+        focus_callback(change);
 }
 
 //------------------------------------------------------------------------
 auto SearchEngine::prev_occurence() -> void
 {
-    const auto results = mam::detail::prev_occurence();
-    callback(results);
+    const auto change = mam::detail::prev_occurence();
+    if (change.current)
+        focus_callback(change);
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::focus_occurence(size_t n) -> void
+{
+    const auto change = mam::detail::focus_occurence(n);
+    if (change.current)
+        focus_callback(change);
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::count_occurences() const -> size_t
+{
+    return SearchEngineCache::instance().hits.size();
 }
 
 //------------------------------------------------------------------------
 auto SearchEngine::clear_results() -> void
 {
+    // Cancels the search which might still be running
+    latest_request++;
+
     const auto results = mam::detail::clear_results();
     callback(results);
 }
@@ -250,5 +570,315 @@ auto SearchEngine::get_callback() -> SearchEngineCallback&
     return callback;
 }
 
+//------------------------------------------------------------------------
+auto SearchEngine::get_focus_callback() -> FocusCallback&
+{
+    return focus_callback;
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::get_search_word_callback() -> SearchWordCallback&
+{
+    return search_word_callback;
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::start_worker() -> void
+{
+    // Every editor starts the worker, only the first one really does
+    if (count_worker_users++ > 0)
+        return;
+
+    // The scan threads live as long as the worker, so none of them is left
+    // running once the last editor is closed
+    scan_pool         = std::make_unique<ThreadPool>(count_scan_threads());
+    stop_requested    = false;
+    is_worker_running = true;
+    worker            = std::thread([this]() { run_worker(); });
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::stop_worker() -> void
+{
+    // The worker keeps running as long as any other editor is open
+    if (count_worker_users == 0 || --count_worker_users > 0)
+        return;
+
+    join_worker();
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::join_worker() -> void
+{
+    if (!is_worker_running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(request_mutex);
+        stop_requested = true;
+        pending_request.reset();
+    }
+
+    latest_request++;
+    request_condition.notify_one();
+    if (worker.joinable())
+        worker.join();
+
+    scan_pool.reset();
+    is_worker_running = false;
+
+    std::lock_guard<std::mutex> lock(batch_mutex);
+    batches.clear();
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::dispatch_results() -> void
+{
+    Batches ready;
+    {
+        std::lock_guard<std::mutex> lock(batch_mutex);
+        ready.swap(batches);
+    }
+
+    for (auto& batch : ready)
+        apply(batch);
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::create_request(const StringType& search_word) -> Request
+{
+    SearchEngineCache::instance().search_word = search_word;
+    search_word_callback(search_word);
+
+    Request request;
+    request.id    = ++latest_request;
+    request.query = text_normalizer::normalize(search_word);
+    take_snapshot(get_regions(), request.regions);
+
+    return request;
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::post(Request&& request) -> void
+{
+    if (!is_worker_running)
+    {
+        // Synchronous, all results arrive in a single batch
+        Batch all{request.id, {}};
+        execute(request, [&](Batch&& batch) {
+            std::move(batch.results.begin(), batch.results.end(),
+                      std::back_inserter(all.results));
+        });
+
+        apply(all);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(request_mutex);
+        pending_request = std::move(request);
+    }
+
+    request_condition.notify_one();
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::execute(const Request& request, const FuncBatch& emit)
+    -> void
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr auto BATCH_INTERVAL = std::chrono::milliseconds(4);
+
+    // Invalid or too complex pattern, nothing to find
+    const auto* pattern = request.pattern.get();
+    if (request.is_pattern && !pattern)
+        return;
+
+    // Several words make a phrase, see lookup_region_phrase
+    const auto tokens    = split_words(request.query);
+    const bool is_phrase = !pattern && tokens.size() > 1;
+    const auto query =
+        tokens.size() == 1 ? tokens.front() : StringView(request.query);
+
+    TokenTerms token_terms;
+    const bool use_index = request.index && request.method;
+    if (use_index && pattern)
+    {
+        // One pass of the DFA per distinct term. Hits of a pattern spanning
+        // several words are only found by scanning the text of the regions.
+        if (!pattern->spans_words())
+            token_terms.push_back(request.index->vocabulary->find_all(
+                [&](StringView term) { return pattern->is_match(term); }));
+    }
+    else if (use_index)
+    {
+        const auto lookups = is_phrase ? tokens : Tokens{query};
+        for (const auto word : lookups)
+        {
+            token_terms.push_back(query_refiner.find_terms(
+                *request.index, word, *request.method));
+        }
+    }
+
+    const auto find_source_index = [&](const RegionSnapshot& region) {
+        const auto* source_index =
+            use_index ? request.index->find_source(region.audio_source_id)
+                      : nullptr;
+
+        // Not indexed yet or outdated, scan instead
+        const bool is_indexed = source_index && source_index->get_store() ==
+                                                    region.words.get_store();
+        return is_indexed ? source_index : nullptr;
+    };
+
+    const auto find_hits = [&](const RegionSnapshot& region) {
+        SearchResult result{region.region_id, {}, std::nullopt, {}};
+        if (is_cancelled(request.id))
+            return result;
+
+        const auto& words        = region.words;
+        const auto* source_index = find_source_index(region);
+        if (is_phrase || (pattern && pattern->spans_words()))
+        {
+            auto hits =
+                pattern        ? scan_region_pattern(words, *pattern)
+                : source_index ? lookup_region_phrase(words, *source_index,
+                                                      token_terms)
+                               : scan_region_phrase(words, tokens,
+                                                    request.match_func);
+            result.indices = std::move(hits.indices);
+            result.ends    = std::move(hits.ends);
+        }
+        else
+        {
+            result.indices =
+                source_index
+                    ? lookup_region_words(words, *source_index,
+                                          token_terms.front())
+                    : scan_region_words(words, query, request.match_func);
+        }
+
+        return result;
+    };
+
+    // The first hits are emitted right away, later ones in batches
+    Batch batch{request.id, {}};
+    auto last_emit     = Clock::time_point{};
+    const auto consume = [&](size_t, SearchResult&& result) {
+        if (is_cancelled(request.id))
+            return false;
+
+        if (result.indices.empty())
+            return true;
+
+        batch.results.push_back(std::move(result));
+        if (Clock::now() - last_emit >= BATCH_INTERVAL)
+        {
+            emit(std::move(batch));
+            batch     = {request.id, {}};
+            last_emit = Clock::now();
+        }
+
+        return true;
+    };
+
+    // Lookups are cheap, but scanning the words of hundreds of regions is
+    // worth spreading over several threads
+    const auto needs_scan = [&](const RegionSnapshot& region) {
+        return !find_source_index(region) ||
+               (pattern && pattern->spans_words());
+    };
+
+    const auto& regions  = request.regions;
+    const auto num_scans = static_cast<size_t>(
+        std::count_if(regions.begin(), regions.end(), needs_scan));
+    if (num_scans >= MIN_PARALLEL_SCANS && scan_pool && scan_pool->size() > 1)
+    {
+        for_each_in_order<SearchResult>(
+            *scan_pool, regions.size(),
+            [&](size_t i) { return find_hits(regions[i]); }, consume);
+    }
+    else
+    {
+        for (size_t i = 0; i < regions.size(); i++)
+        {
+            if (!consume(i, find_hits(regions[i])))
+                return;
+        }
+    }
+
+    if (is_cancelled(request.id))
+        return;
+
+    if (!batch.results.empty())
+        emit(std::move(batch));
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::run_worker() -> void
+{
+    while (true)
+    {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(request_mutex);
+            request_condition.wait(lock, [this]() {
+                return stop_requested || pending_request.has_value();
+            });
+
+            if (stop_requested)
+                return;
+
+            request = std::move(*pending_request);
+            pending_request.reset();
+        }
+
+        if (is_cancelled(request.id))
+            continue;
+
+        try
+        {
+            execute(request, [this](Batch&& batch) {
+                std::lock_guard<std::mutex> lock(batch_mutex);
+                batches.push_back(std::move(batch));
+            });
+        }
+        catch (...)
+        {
+            // The failed search ends with the batches found so far, the
+            // worker stays ready for the next one
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+auto SearchEngine::apply(Batch& batch) -> void
+{
+    // Batches of a cancelled search
+    if (is_cancelled(batch.request_id) || batch.results.empty())
+        return;
+
+    // Focus the first word
+    auto& cache = SearchEngineCache::instance();
+    if (cache.search_results.empty())
+    {
+        constexpr auto DEFAULT_WORD_INDEX   = 0;
+        batch.results.front().focused_word = DEFAULT_WORD_INDEX;
+        cache.focused_hit                  = 0;
+    }
+
+    // Batches arrive in timeline order, so the hits are simply appended
+    for (const auto& result : batch.results)
+    {
+        const auto result_index = cache.search_results.size();
+        for (size_t hit = 0; hit < result.indices.size(); hit++)
+            cache.hits.push_back({result_index, hit});
+
+        cache.search_results.push_back(result);
+    }
+
+    callback(batch.results);
+}
+
 //------------------------------------------------------------------------
 } // namespace mam
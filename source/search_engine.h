@@ -3,11 +3,23 @@
 #pragma once
 
 #include "meta_words_playback_region.h"
+#include "pattern_matcher.h"
+#include "query_refiner.h"
+#include "search_index.h"
+#include "string_matcher.h"
+#include "thread_pool.h"
 #include "warn_cpp/suppress_warnings.h"
+#include "region_data.h"
 #include "wordify_types.h"
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string_view>
+#include <thread>
 #include <vector>
 BEGIN_SUPPRESS_WARNINGS
 #include "eventpp/callbacklist.h"
@@ -21,6 +33,29 @@ namespace mam {
 
 //------------------------------------------------------------------------
 // SearchEngine
+//
+// Exact, substring and fuzzy matches are looked up in the SearchIndex, if
+// one is provided. Queries of several words are phrase searches: every word
+// of the query must match consecutive words of a region, punctuation marks
+// in between are skipped. Regular expressions and wildcards are compiled to
+// a DFA which runs over the vocabulary, or over the text of the region if a
+// pattern can span several words. While typing, the QueryRefiner narrows
+// the terms of the previous query down. Custom match functions and regions
+// whose audio source is not indexed (yet) scan the words of the region
+// instead. With enough regions to scan, the worker splits the regions across
+// the threads of a pool and merges their results back in region order.
+//
+// Once the worker is started, searches run on a background thread against
+// an immutable snapshot of the regions' words and the search index. Every
+// new search cancels the one still running. Results are streamed back in
+// timeline order as batches and handed to the callback by dispatch_results()
+// on the UI thread. Without the worker, searches run synchronously. The
+// engine is shared by all editors, so the worker is reference counted:
+// every start_worker() needs its stop_worker().
+//
+// All hits are also kept in one flat list in timeline order, so moving the
+// focus to the next, previous or nth occurence is O(1) and only reports the
+// previously and the newly focused occurence to the focus callback.
 //------------------------------------------------------------------------
 class SearchEngine
 {
@@ -41,15 +76,50 @@ public:
     struct SearchResult
     {
         RegionID region_id = 0;
-        WordIndices indices;
+        WordIndices indices; // First word of every hit, ascending
         OptWord focused_word;
+
+        // One past the last word of every hit, empty if all hits are single
+        // words. Phrase hits span several words.
+        WordIndices ends;
+
+        auto hit_end(size_t hit) const -> WordIndex
+        {
+            return ends.empty() ? indices[hit] + 1 : ends[hit];
+        }
+
+        /** Hit covering the word, if any */
+        auto find_hit(WordIndex word_index) const -> OptWord;
     };
 
     using SearchResults = std::vector<SearchResult>;
+
+    struct Occurence
+    {
+        RegionID region_id = 0;
+        WordIndex first    = 0;
+        WordIndex end      = 0; // One past the last word
+    };
+
+    using OptOccurence = std::optional<Occurence>;
+
+    struct FocusChange
+    {
+        OptOccurence previous;
+        OptOccurence current;
+    };
+
+    /** Called with the normalized word and query, see text_normalizer.
+     *  Might be called from several threads at once.
+     */
     using MatchFunc =
-        std::function<bool(const StringType& s0, const StringType& s1)>;
+        std::function<bool(std::string_view word, std::string_view query)>;
+    using MatchMethod = StringMatcher::MatchMethod;
     using SearchEngineCallback =
         eventpp::CallbackList<void(const SearchResults&)>;
+    using FocusCallback = eventpp::CallbackList<void(const FocusChange&)>;
+    using SearchWordCallback =
+        eventpp::CallbackList<void(const StringType& search_word)>;
 
     static SearchEngine& instance()
     {
@@ -57,20 +127,103 @@ public:
         return cache;
     }
 
+    ~SearchEngine();
+
     auto search(const StringType& search_word, MatchFunc&& match_func) -> void;
+    auto search(const StringType& search_word, MatchMethod method) -> void;
     auto research(MatchFunc&& match_func) -> void;
+    auto research(MatchMethod method) -> void;
     auto next_occurence() -> void;
     auto prev_occurence() -> void;
+    /** Jumps to the nth occurence of all regions, in timeline order */
+    auto focus_occurence(size_t n) -> void;
+    auto count_occurences() const -> size_t;
     auto clear_results() -> void;
     auto current_search_word() -> StringType;
     auto get_callback() -> SearchEngineCallback&;
+    auto get_focus_callback() -> FocusCallback&;
+
+    /** Called with the search word of every search, whoever started it */
+    auto get_search_word_callback() -> SearchWordCallback&;
+
+    /** UI thread only, see class description */
+    auto start_worker() -> void;
+    auto stop_worker() -> void;
+
+    /** UI thread, hands the batches found so far to the callback */
+    auto dispatch_results() -> void;
 
     using FuncRegions = std::function<const Regions()>;
     FuncRegions get_regions;
 
+    using FuncSearchIndex = std::function<SearchIndex::Snapshot()>;
+    FuncSearchIndex get_search_index;
+
     //--------------------------------------------------------------------
 private:
+    using RequestId = uint64_t;
+
+    struct RegionSnapshot
+    {
+        RegionID region_id = 0;
+        Id audio_source_id = 0;
+        RegionWords words;
+    };
+
+    using RegionSnapshots = std::vector<RegionSnapshot>;
+
+    struct Request
+    {
+        RequestId id = 0;
+        StringType query; // Normalized
+        std::optional<MatchMethod> method;
+        MatchFunc match_func;
+        bool is_pattern = false;
+        PatternMatcher::PatternMatcherPtr pattern; // None if invalid
+        RegionSnapshots regions;
+        std::optional<SearchIndex::Snapshot> index;
+    };
+
+    struct Batch
+    {
+        RequestId request_id = 0;
+        SearchResults results;
+    };
+
+    using Batches   = std::vector<Batch>;
+    using FuncBatch = std::function<void(Batch&&)>;
+
+    auto create_request(const StringType& search_word) -> Request;
+    auto post(Request&& request) -> void;
+    auto execute(const Request& request, const FuncBatch& emit) -> void;
+    auto run_worker() -> void;
+    auto join_worker() -> void;
+    auto apply(Batch& batch) -> void;
+    auto is_cancelled(RequestId id) const -> bool
+    {
+        return id != latest_request.load();
+    }
+
     SearchEngineCallback callback;
+    FocusCallback focus_callback;
+    SearchWordCallback search_word_callback;
+
+    // Only used by the thread executing the searches
+    QueryRefiner query_refiner;
+    std::unique_ptr<ThreadPool> scan_pool; // Lives as long as the worker
+
+    std::atomic<RequestId> latest_request{0};
+    std::thread worker;
+    bool is_worker_running    = false;
+    size_t count_worker_users = 0;
+
+    std::mutex request_mutex;
+    std::condition_variable request_condition;
+    std::optional<Request> pending_request;
+    bool stop_requested = false;
+
+    std::mutex batch_mutex;
+    Batches batches;
 };
 
 //------------------------------------------------------------------------
@@ -0,0 +1,437 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "search_index.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace mam {
+namespace {
+
+//------------------------------------------------------------------------
+template <typename T>
+auto capacity_bytes(const std::vector<T>& vec) -> size_t
+{
+    return vec.capacity() * sizeof(T);
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// Vocabulary::Segment
+//------------------------------------------------------------------------
+Vocabulary::Segment::Segment(TermId first_id, const StemmerPtr& stemmer)
+: first_id(first_id)
+, stem_index(stemmer)
+{
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::Segment::add(StringType&& term) -> void
+{
+    const auto term_id = static_cast<TermId>(terms.size());
+    terms.push_back(std::move(term));
+    term_ids.emplace(StringView(terms.back()), term_id);
+    trigram_index.add(term_id, terms.back());
+    bk_tree.add(term_id, terms);
+    phonetic_index.add(term_id, terms.back());
+    stem_index.add(term_id, terms.back());
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::Segment::memory_usage() const -> size_t
+{
+    // Rough estimate, every term plus one hash node
+    size_t bytes = sizeof(Segment) + terms.size() * sizeof(StringType);
+    for (const auto& term : terms)
+        bytes += term.capacity();
+
+    bytes += term_ids.size() * (sizeof(TermIdMap::value_type) + sizeof(void*));
+    bytes += term_ids.bucket_count() * sizeof(void*);
+    bytes += trigram_index.memory_usage();
+    bytes += bk_tree.memory_usage();
+    bytes += phonetic_index.memory_usage();
+    bytes += stem_index.memory_usage();
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------
+// Vocabulary
+//------------------------------------------------------------------------
+Vocabulary::Vocabulary(StemmerPtr stemmer)
+: stemmer(std::move(stemmer))
+{
+}
+
+//------------------------------------------------------------------------
+Vocabulary::Vocabulary(const Vocabulary& other)
+: stemmer(other.stemmer)
+, segments(other.segments)
+, count_terms(other.count_terms)
+, is_last_shared(true)
+{
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::intern(StringView term) -> TermId
+{
+    if (const auto term_id = find(term))
+        return *term_id;
+
+    auto& segment = get_mutable_segment();
+    segment.add(StringType(term));
+    count_terms++;
+
+    return static_cast<TermId>(count_terms - 1);
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::find(StringView term) const -> OptTermId
+{
+    for (const auto& segment : segments)
+    {
+        const auto iter = segment->term_ids.find(term);
+        if (iter != segment->term_ids.end())
+            return segment->first_id + iter->second;
+    }
+
+    return std::nullopt;
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::find_containing(StringView query) const -> TermIds
+{
+    TermIds result;
+    for (const auto& segment : segments)
+    {
+        const auto& terms   = segment->terms;
+        const auto contains = [&](TermId term_id) {
+            return StringView(terms[term_id]).find(query) != StringView::npos;
+        };
+
+        if (query.size() < TrigramIndex::GRAM_SIZE)
+        {
+            // Too short for trigrams, but still one check per distinct term
+            for (TermId term_id = 0; term_id < terms.size(); term_id++)
+            {
+                if (contains(term_id))
+                    result.push_back(segment->first_id + term_id);
+            }
+
+            continue;
+        }
+
+        for (const auto term_id :
+             segment->trigram_index.find_candidates(query))
+        {
+            if (contains(term_id))
+                result.push_back(segment->first_id + term_id);
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::find_similar(StringView query, size_t max_distance) const
+    -> TermIds
+{
+    TermIds result;
+    for (const auto& segment : segments)
+    {
+        for (const auto term_id :
+             segment->bk_tree.find(query, max_distance, segment->terms))
+            result.push_back(segment->first_id + term_id);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::find_sounding_like(StringView query) const -> TermIds
+{
+    // Encoded once for all segments
+    const auto keys = double_metaphone::encode(query);
+
+    TermIds result;
+    for (const auto& segment : segments)
+    {
+        for (const auto term_id : segment->phonetic_index.find(keys))
+            result.push_back(segment->first_id + term_id);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::find_same_stem(StringView query) const -> TermIds
+{
+    // Stemmed once for all segments
+    const auto stem = stemmer->stem(query);
+
+    TermIds result;
+    for (const auto& segment : segments)
+    {
+        for (const auto term_id : segment->stem_index.find(stem))
+            result.push_back(segment->first_id + term_id);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::term(TermId term_id) const -> StringView
+{
+    const auto iter = std::upper_bound(
+        segments.begin(), segments.end(), term_id,
+        [](TermId id, const SegmentPtr& segment) {
+            return id < segment->first_id;
+        });
+
+    const auto& segment = **std::prev(iter);
+    return segment.terms[term_id - segment.first_id];
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::memory_usage() const -> size_t
+{
+    size_t bytes = sizeof(Vocabulary) + capacity_bytes(segments);
+    for (const auto& segment : segments)
+        bytes += segment->memory_usage();
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::get_mutable_segment() -> Segment&
+{
+    // A shared segment belongs to a snapshot as well and must not change
+    if (segments.empty() || is_last_shared)
+    {
+        merge_segments();
+        segments.push_back(std::make_shared<Segment>(
+            static_cast<TermId>(count_terms), stemmer));
+        is_last_shared = false;
+    }
+
+    return *segments.back();
+}
+
+//------------------------------------------------------------------------
+auto Vocabulary::merge_segments() -> void
+{
+    // Every segment ends up at least twice as large as its successor. The
+    // merged segment is a new one, snapshots keep the ones they know.
+    while (segments.size() > 1)
+    {
+        const auto& last = segments.back();
+        const auto& prev = segments[segments.size() - 2];
+        if (prev->terms.size() >= 2 * last->terms.size())
+            break;
+
+        auto merged = std::make_shared<Segment>(prev->first_id, stemmer);
+        for (const auto& term : prev->terms)
+            merged->add(StringType(term));
+        for (const auto& term : last->terms)
+            merged->add(StringType(term));
+
+        segments.pop_back();
+        segments.back() = std::move(merged);
+    }
+}
+
+//------------------------------------------------------------------------
+// SourceIndex
+//------------------------------------------------------------------------
+auto SourceIndex::create(const WordStorePtr& store, Vocabulary& vocabulary)
+    -> SourceIndexPtr
+{
+    auto index   = std::shared_ptr<SourceIndex>(new SourceIndex);
+    index->store = store;
+    if (!store)
+        return index;
+
+    // Map the store's interned words onto the vocabulary. Several words can
+    // share a term e.g. "Hello," and "hello".
+    const auto count_store_terms = store->count_terms();
+    index->store_terms.reserve(count_store_terms);
+    for (size_t i = 0; i < count_store_terms; i++)
+    {
+        const auto normalized =
+            store->term_normalized(static_cast<TermId>(i));
+        index->store_terms.push_back(normalized.empty()
+                                         ? Vocabulary::INVALID_TERM
+                                         : vocabulary.intern(normalized));
+    }
+
+    auto& terms = index->terms;
+    terms       = index->store_terms;
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    if (!terms.empty() && terms.back() == Vocabulary::INVALID_TERM)
+        terms.pop_back();
+
+    // Local slot of every store term in 'terms'
+    TermIds slots(count_store_terms, Vocabulary::INVALID_TERM);
+    for (size_t i = 0; i < count_store_terms; i++)
+    {
+        const auto term = index->store_terms[i];
+        if (term == Vocabulary::INVALID_TERM)
+            continue;
+
+        const auto iter = std::lower_bound(terms.begin(), terms.end(), term);
+        slots[i]        = static_cast<TermId>(iter - terms.begin());
+    }
+
+    // Counting sort of all words by slot. Words are visited in ascending
+    // order, so every postings list ends up sorted.
+    auto& offsets = index->offsets;
+    offsets.assign(terms.size() + 1, 0);
+    for (Index i = 0; i < store->size(); i++)
+    {
+        const auto slot = slots[store->term(i)];
+        if (slot != Vocabulary::INVALID_TERM)
+            offsets[slot + 1]++;
+    }
+
+    for (size_t i = 1; i < offsets.size(); i++)
+        offsets[i] += offsets[i - 1];
+
+    auto fill_pos = Offsets(offsets.begin(), offsets.end() - 1);
+    index->all_postings.resize(offsets.back());
+    for (Index i = 0; i < store->size(); i++)
+    {
+        const auto slot = slots[store->term(i)];
+        if (slot != Vocabulary::INVALID_TERM)
+            index->all_postings[fill_pos[slot]++] = static_cast<Posting>(i);
+    }
+
+    return index;
+}
+
+//------------------------------------------------------------------------
+auto SourceIndex::postings(TermId term) const -> Postings
+{
+    const auto iter = std::lower_bound(terms.begin(), terms.end(), term);
+    if (iter == terms.end() || *iter != term)
+        return {};
+
+    const auto slot  = static_cast<size_t>(iter - terms.begin());
+    const auto begin = offsets[slot];
+    const auto count = offsets[slot + 1] - begin;
+
+    return Postings(all_postings.data() + begin, count);
+}
+
+//------------------------------------------------------------------------
+auto SourceIndex::memory_usage() const -> size_t
+{
+    return sizeof(SourceIndex) + capacity_bytes(store_terms) +
+           capacity_bytes(terms) + capacity_bytes(offsets) +
+           capacity_bytes(all_postings);
+}
+
+//------------------------------------------------------------------------
+// SearchIndex::Snapshot
+//------------------------------------------------------------------------
+auto SearchIndex::Snapshot::find_source(Id source_id) const
+    -> const SourceIndex*
+{
+    const auto iter = sources.find(source_id);
+    return iter != sources.end() ? iter->second.get() : nullptr;
+}
+
+//------------------------------------------------------------------------
+// SearchIndex
+//------------------------------------------------------------------------
+SearchIndex::SearchIndex(StringView language)
+: stemmer(Stemmer::create(language))
+, vocabulary(std::make_shared<Vocabulary>(stemmer))
+{
+}
+
+//------------------------------------------------------------------------
+auto SearchIndex::update_source(Id source_id, const WordStorePtr& store)
+    -> void
+{
+    if (!store)
+    {
+        remove_source(source_id);
+        return;
+    }
+
+    const auto iter = sources.find(source_id);
+    if (iter != sources.end() && iter->second->get_store() == store)
+        return;
+
+    using Clock      = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    sources[source_id] =
+        SourceIndex::create(store, get_mutable_vocabulary());
+    generation++;
+
+    stats.last_build_duration =
+        std::chrono::duration_cast<Microseconds>(Clock::now() - start);
+    stats.total_build_duration += stats.last_build_duration;
+    stats.count_builds++;
+}
+
+//------------------------------------------------------------------------
+auto SearchIndex::remove_source(Id source_id) -> void
+{
+    // Terms stay in the vocabulary, their ids must remain stable
+    if (sources.erase(source_id) > 0)
+        generation++;
+}
+
+//------------------------------------------------------------------------
+auto SearchIndex::clear() -> void
+{
+    sources.clear();
+    vocabulary           = std::make_shared<Vocabulary>(stemmer);
+    is_vocabulary_shared = false;
+    generation++;
+}
+
+//------------------------------------------------------------------------
+auto SearchIndex::get_stats() const -> Stats
+{
+    auto result          = stats;
+    result.count_sources = sources.size();
+    result.count_terms   = vocabulary->size();
+    result.count_words   = 0;
+    for (const auto& source : sources)
+        result.count_words += source.second->count_words();
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+auto SearchIndex::memory_usage() const -> size_t
+{
+    size_t bytes = sizeof(SearchIndex) + vocabulary->memory_usage();
+    for (const auto& source : sources)
+        bytes += source.second->memory_usage();
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------
+auto SearchIndex::get_mutable_vocabulary() -> Vocabulary&
+{
+    // Copy on write, snapshots might still refer to the current vocabulary.
+    // The copy shares all segments, see Vocabulary.
+    if (is_vocabulary_shared)
+    {
+        vocabulary           = std::make_shared<Vocabulary>(*vocabulary);
+        is_vocabulary_shared = false;
+    }
+
+    return *vocabulary;
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,266 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "bk_tree.h"
+#include "nonstd.h"
+#include "phonetic_index.h"
+#include "stem_index.h"
+#include "trigram_index.h"
+#include "word_store.h"
+#include "wordify_types.h"
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// Vocabulary
+//
+// All distinct normalized terms of the document. Terms are only ever
+// appended, so a term id stays valid for the lifetime of the document.
+// Substring lookups go through a trigram index, fuzzy lookups through a
+// BK-tree, sounds-like lookups through the phonetic keys and stemmed
+// lookups through the stems of all terms, see Stemmer.
+//
+// The terms and their indices live in segments of consecutive term ids.
+// Copying a vocabulary only copies the segment pointers, the copy puts new
+// terms into a segment of its own. So the original never sees a change and
+// an update never clones what is there already. Small trailing segments are
+// merged, which keeps their count logarithmic in the number of terms.
+//------------------------------------------------------------------------
+class Vocabulary
+{
+public:
+    //--------------------------------------------------------------------
+    using TermId     = uint32_t;
+    using TermIds    = std::vector<TermId>;
+    using OptTermId  = std::optional<TermId>;
+    using StringView = std::string_view;
+    using StemmerPtr = Stemmer::StemmerPtr;
+
+    static constexpr TermId INVALID_TERM = std::numeric_limits<TermId>::max();
+
+    explicit Vocabulary(StemmerPtr stemmer);
+
+    /** Shares all segments, the original must not change anymore */
+    Vocabulary(const Vocabulary& other);
+    Vocabulary& operator=(const Vocabulary&) = delete;
+
+    auto intern(StringView term) -> TermId;
+    auto find(StringView term) const -> OptTermId;
+
+    /** All terms containing the query, ascending */
+    auto find_containing(StringView query) const -> TermIds;
+
+    /** All terms within the edit distance of the query, ascending */
+    auto find_similar(StringView query, size_t max_distance) const -> TermIds;
+
+    /** All terms sounding like the query, ascending */
+    auto find_sounding_like(StringView query) const -> TermIds;
+
+    /** All terms with the same stem as the query, ascending */
+    auto find_same_stem(StringView query) const -> TermIds;
+
+    /** All terms passing the predicate, ascending */
+    template <typename Predicate>
+    auto find_all(Predicate&& predicate) const -> TermIds
+    {
+        TermIds result;
+        for (const auto& segment : segments)
+        {
+            const auto& terms = segment->terms;
+            for (TermId i = 0; i < terms.size(); i++)
+            {
+                if (predicate(StringView(terms[i])))
+                    result.push_back(segment->first_id + i);
+            }
+        }
+
+        return result;
+    }
+
+    auto term(TermId term_id) const -> StringView;
+    auto size() const -> size_t { return count_terms; }
+    auto count_segments() const -> size_t { return segments.size(); }
+    auto get_stemmer() const -> const StemmerPtr& { return stemmer; }
+    auto memory_usage() const -> size_t;
+
+    //--------------------------------------------------------------------
+private:
+    using TermIdMap = std::unordered_map<StringView, TermId>;
+    using Terms     = BkTree::Terms;
+
+    // Term ids inside a segment are local, starting at 0. The keys of
+    // term_ids refer to terms, which never move.
+    struct Segment
+    {
+        Segment(TermId first_id, const StemmerPtr& stemmer);
+        Segment(const Segment&) = delete;
+        Segment& operator=(const Segment&) = delete;
+
+        auto add(StringType&& term) -> void;
+        auto memory_usage() const -> size_t;
+
+        TermId first_id = 0;
+        TermIdMap term_ids;
+        Terms terms;
+        TrigramIndex trigram_index;
+        BkTree bk_tree;
+        PhoneticIndex phonetic_index;
+        StemIndex stem_index;
+    };
+
+    using SegmentPtr = std::shared_ptr<Segment>;
+    using Segments   = std::vector<SegmentPtr>;
+
+    auto get_mutable_segment() -> Segment&;
+    auto merge_segments() -> void;
+
+    StemmerPtr stemmer;
+    Segments segments;
+    size_t count_terms  = 0;
+    bool is_last_shared = false; // The last segment belongs to a copy too
+};
+
+//------------------------------------------------------------------------
+// SourceIndex
+//
+// Immutable inverted index of one audio source's WordStore. Maps vocabulary
+// terms to the ascending word indices they occur at (postings), stored in
+// CSR layout: one offsets array and one contiguous postings array. Words
+// are the store's global indices, regions pick their share by the window.
+//------------------------------------------------------------------------
+class SourceIndex
+{
+public:
+    //--------------------------------------------------------------------
+    using TermId         = Vocabulary::TermId;
+    using Posting        = uint32_t;
+    using Postings       = nonstd::span<const Posting>;
+    using WordStorePtr   = meta_words::WordStorePtr;
+    using SourceIndexPtr = std::shared_ptr<const SourceIndex>;
+
+    static auto create(const WordStorePtr& store, Vocabulary& vocabulary)
+        -> SourceIndexPtr;
+
+    auto get_store() const -> const WordStorePtr& { return store; }
+
+    /** Vocabulary term of a word, INVALID_TERM for punctuation marks */
+    auto term(Index word_index) const -> TermId
+    {
+        return store_terms[store->term(word_index)];
+    }
+
+    auto postings(TermId term) const -> Postings;
+    auto count_terms() const -> size_t { return terms.size(); }
+    auto count_words() const -> size_t { return store->size(); }
+    auto memory_usage() const -> size_t;
+
+    //--------------------------------------------------------------------
+private:
+    using TermIds     = std::vector<TermId>;
+    using Offsets     = std::vector<uint32_t>;
+    using PostingList = std::vector<Posting>;
+
+    SourceIndex() = default;
+
+    WordStorePtr store;
+    TermIds store_terms; // WordStore term -> vocabulary term
+    TermIds terms;       // Sorted vocabulary terms of this source
+
+    // Postings of terms[i] are all_postings[offsets[i], offsets[i + 1])
+    Offsets offsets{0};
+    PostingList all_postings;
+};
+
+//------------------------------------------------------------------------
+// SearchIndex
+//
+// Document wide search index: the shared vocabulary and one SourceIndex per
+// analysed audio source. Only the source whose analysis finished is
+// (re)indexed. Region clipping needs no update at all, since regions are
+// mapped onto postings through their windows at query time.
+//
+// A Snapshot is a cheap copy of shared pointers and stays valid even while
+// the index is updated. Its generation changes with every update, so results
+// cached for one snapshot can be told apart from the next one. Snapshots
+// are taken on the thread updating the index, but may be released on any
+// other one.
+//------------------------------------------------------------------------
+class SearchIndex
+{
+public:
+    //--------------------------------------------------------------------
+    using TermId         = Vocabulary::TermId;
+    using VocabularyPtr  = std::shared_ptr<const Vocabulary>;
+    using SourceIndexPtr = SourceIndex::SourceIndexPtr;
+    using SourceIndices  = std::map<Id, SourceIndexPtr>;
+    using WordStorePtr   = meta_words::WordStorePtr;
+    using Microseconds   = std::chrono::microseconds;
+    using Generation     = uint64_t;
+
+    struct Snapshot
+    {
+        VocabularyPtr vocabulary;
+        SourceIndices sources;
+        Generation generation = 0;
+
+        auto find_source(Id source_id) const -> const SourceIndex*;
+    };
+
+    struct Stats
+    {
+        // Source indices built since creation
+        size_t count_builds  = 0;
+        size_t count_sources = 0;
+        size_t count_words   = 0;
+        size_t count_terms   = 0;
+        Microseconds last_build_duration{0};
+        Microseconds total_build_duration{0};
+    };
+
+    using StringView     = std::string_view;
+
+    /** Terms are stemmed in the language, an ISO 639-1 code. Only English
+     *  is supported so far, see Stemmer::create */
+    explicit SearchIndex(StringView language);
+
+    /** Indexes the store of the audio source, unless it is indexed already */
+    auto update_source(Id source_id, const WordStorePtr& store) -> void;
+    auto remove_source(Id source_id) -> void;
+    auto clear() -> void;
+
+    auto get_snapshot() const -> Snapshot
+    {
+        is_vocabulary_shared = true;
+        return {vocabulary, sources, generation};
+    }
+    auto get_stats() const -> Stats;
+    auto memory_usage() const -> size_t;
+
+    //--------------------------------------------------------------------
+private:
+    auto get_mutable_vocabulary() -> Vocabulary&;
+
+    Vocabulary::StemmerPtr stemmer;
+    std::shared_ptr<Vocabulary> vocabulary;
+    SourceIndices sources;
+    Generation generation = 0;
+    Stats stats;
+
+    // Set by every snapshot, so the next update copies the vocabulary.
+    // Counting its references instead would race with snapshots released
+    // on other threads.
+    mutable bool is_vocabulary_shared = false;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,98 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// SpscRingBuffer
+//
+// Lock free ring buffer for exactly one producer and one consumer thread.
+// Both push and pop are wait free and never allocate. The capacity is
+// rounded up to a power of two and must be set while no thread is using the
+// buffer.
+//------------------------------------------------------------------------
+template <typename T>
+class SpscRingBuffer
+{
+public:
+    //--------------------------------------------------------------------
+    auto resize(size_t min_capacity) -> void
+    {
+        size_t capacity = 1;
+        while (capacity < min_capacity)
+            capacity <<= 1;
+
+        buffer.assign(capacity, T{});
+        mask = capacity - 1;
+        write_pos.store(0, std::memory_order_relaxed);
+        read_pos.store(0, std::memory_order_relaxed);
+    }
+
+    auto capacity() const -> size_t { return buffer.size(); }
+
+    /** Producer only. Returns the number of elements written, which is less
+     *  than 'count' when the buffer is full. */
+    auto push(const T* data, size_t count) -> size_t
+    {
+        const auto write = write_pos.load(std::memory_order_relaxed);
+        const auto read  = read_pos.load(std::memory_order_acquire);
+
+        count = std::min(count, buffer.size() - (write - read));
+        for (size_t i = 0; i < count; i++)
+            buffer[(write + i) & mask] = data[i];
+
+        write_pos.store(write + count, std::memory_order_release);
+        return count;
+    }
+
+    /** Consumer only. Returns the number of elements read. */
+    auto pop(T* data, size_t count) -> size_t
+    {
+        const auto read  = read_pos.load(std::memory_order_relaxed);
+        const auto write = write_pos.load(std::memory_order_acquire);
+
+        count = std::min(count, write - read);
+        for (size_t i = 0; i < count; i++)
+            data[i] = buffer[(read + i) & mask];
+
+        read_pos.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+    /** Consumer only. Number of elements ready to be read. */
+    auto size() const -> size_t
+    {
+        const auto read = read_pos.load(std::memory_order_relaxed);
+        return write_pos.load(std::memory_order_acquire) - read;
+    }
+
+    /** Consumer only. Drops up to 'count' elements without reading them and
+     *  returns the number dropped. */
+    auto skip(size_t count) -> size_t
+    {
+        const auto read  = read_pos.load(std::memory_order_relaxed);
+        const auto write = write_pos.load(std::memory_order_acquire);
+
+        count = std::min(count, write - read);
+        read_pos.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+    //--------------------------------------------------------------------
+private:
+    std::vector<T> buffer;
+    size_t mask = 0;
+
+    // Positions only ever grow, the difference is the fill level.
+    alignas(64) std::atomic<size_t> write_pos{0};
+    alignas(64) std::atomic<size_t> read_pos{0};
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
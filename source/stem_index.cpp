@@ -0,0 +1,46 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "stem_index.h"
+#include <utility>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// StemIndex
+//------------------------------------------------------------------------
+StemIndex::StemIndex(StemmerPtr stemmer)
+: stemmer(std::move(stemmer))
+{
+}
+
+//------------------------------------------------------------------------
+auto StemIndex::add(TermId term_id, StringView term) -> void
+{
+    postings[stemmer->stem(term)].push_back(term_id);
+}
+
+//------------------------------------------------------------------------
+auto StemIndex::find(const StringType& stem) const -> TermIds
+{
+    const auto iter = postings.find(stem);
+    if (iter == postings.end())
+        return {};
+
+    return iter->second;
+}
+
+//------------------------------------------------------------------------
+auto StemIndex::memory_usage() const -> size_t
+{
+    size_t bytes = sizeof(StemIndex);
+    for (const auto& entry : postings)
+        bytes += sizeof(entry) + sizeof(void*) + entry.first.capacity() +
+                 entry.second.capacity() * sizeof(TermId);
+
+    bytes += postings.bucket_count() * sizeof(void*);
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,51 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "stemmer.h"
+#include "wordify_types.h"
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// StemIndex
+//
+// Maps the stems of the vocabulary terms to the ascending ids of the terms
+// sharing them, so "record" finds "recording", "recorded" and "records".
+// Every term is stemmed once when it is added. The query is stemmed once by
+// the caller, so looking it up in several indices costs one hash lookup
+// each.
+//------------------------------------------------------------------------
+class StemIndex
+{
+public:
+    //--------------------------------------------------------------------
+    using TermId     = uint32_t;
+    using TermIds    = std::vector<TermId>;
+    using StringView = std::string_view;
+    using StemmerPtr = Stemmer::StemmerPtr;
+
+    explicit StemIndex(StemmerPtr stemmer);
+
+    /** Terms must be added with ascending ids */
+    auto add(TermId term_id, StringView term) -> void;
+
+    /** All terms with the stem, ascending. The stem is the one of the
+     *  stemmer of the index */
+    auto find(const StringType& stem) const -> TermIds;
+    auto memory_usage() const -> size_t;
+
+    //--------------------------------------------------------------------
+private:
+    using Postings = std::unordered_map<StringType, TermIds>;
+
+    StemmerPtr stemmer;
+    Postings postings;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
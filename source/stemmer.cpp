@@ -0,0 +1,358 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "stemmer.h"
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <utility>
+
+namespace mam {
+namespace {
+
+//------------------------------------------------------------------------
+// Sorted and normalized, so "don't" is "dont"
+constexpr std::array<std::string_view, 129> ENGLISH_STOP_WORDS = {
+    "a", "about", "above", "after", "again", "against", "all", "am", "an",
+    "and", "any", "are", "as", "at", "be", "because", "been", "before",
+    "being", "below", "between", "both", "but", "by", "can", "could", "did",
+    "do", "does", "doing", "dont", "down", "during", "each", "few", "for",
+    "from", "further", "had", "has", "have", "having", "he", "her", "here",
+    "hers", "herself", "him", "himself", "his", "how", "i", "if", "im", "in",
+    "into", "is", "it", "its", "itself", "just", "me", "more", "most", "my",
+    "myself", "no", "nor", "not", "now", "of", "off", "on", "once", "only",
+    "or", "other", "our", "ours", "ourselves", "out", "over", "own", "same",
+    "she", "should", "so", "some", "such", "than", "that", "thats", "the",
+    "their", "theirs", "them", "themselves", "then", "there", "these", "they",
+    "this", "those", "through", "to", "too", "under", "until", "up", "very",
+    "was", "we", "were", "what", "when", "where", "which", "while", "who",
+    "whom", "why", "will", "with", "would", "you", "your", "yours", "yourself",
+    "yourselves"};
+
+//------------------------------------------------------------------------
+// Porter's algorithm works on b[0, k], j marks the end of the stem once a
+// suffix has been found by ends().
+//------------------------------------------------------------------------
+class PorterAlgorithm
+{
+public:
+    //--------------------------------------------------------------------
+    using StringView = std::string_view;
+
+    explicit PorterAlgorithm(StringView word)
+    : b(word)
+    , k(static_cast<int>(word.size()) - 1)
+    {
+    }
+
+    auto run() -> StringType
+    {
+        step1ab();
+        if (k > 0)
+        {
+            step1c();
+            step2();
+            step3();
+            step4();
+            step5();
+        }
+
+        b.resize(k + 1);
+        return std::move(b);
+    }
+
+    //--------------------------------------------------------------------
+private:
+    auto is_consonant(int i) const -> bool
+    {
+        switch (b[i])
+        {
+            case 'a':
+            case 'e':
+            case 'i':
+            case 'o':
+            case 'u': return false;
+            case 'y': return i == 0 || !is_consonant(i - 1);
+            default: return true;
+        }
+    }
+
+    /** Number of vowel consonant sequences in b[0, j] */
+    auto measure() const -> int
+    {
+        int n = 0;
+        int i = 0;
+        while (i <= j && is_consonant(i))
+            i++;
+
+        while (i <= j)
+        {
+            while (i <= j && !is_consonant(i))
+                i++;
+            if (i > j)
+                break;
+
+            while (i <= j && is_consonant(i))
+                i++;
+            n++;
+        }
+
+        return n;
+    }
+
+    auto has_vowel_in_stem() const -> bool
+    {
+        for (int i = 0; i <= j; i++)
+        {
+            if (!is_consonant(i))
+                return true;
+        }
+
+        return false;
+    }
+
+    auto is_double_consonant(int i) const -> bool
+    {
+        return i >= 1 && b[i] == b[i - 1] && is_consonant(i);
+    }
+
+    /** Consonant vowel consonant, the last one not w, x or y e.g. "hop" */
+    auto is_cvc(int i) const -> bool
+    {
+        if (i < 2 || !is_consonant(i) || is_consonant(i - 1) ||
+            !is_consonant(i - 2))
+            return false;
+
+        return b[i] != 'w' && b[i] != 'x' && b[i] != 'y';
+    }
+
+    auto ends(StringView suffix) -> bool
+    {
+        const auto length = static_cast<int>(suffix.size());
+        if (length > k + 1 ||
+            StringView(b).substr(k + 1 - length, length) != suffix)
+            return false;
+
+        j = k - length;
+        return true;
+    }
+
+    auto set_to(StringView suffix) -> void
+    {
+        b.replace(j + 1, k - j, suffix);
+        k = j + static_cast<int>(suffix.size());
+        b.resize(k + 1);
+    }
+
+    auto replace(StringView suffix) -> void
+    {
+        if (measure() > 0)
+            set_to(suffix);
+    }
+
+    /** Replaces the first suffix found, returns whether there was one */
+    auto replace_any(
+        std::initializer_list<std::pair<StringView, StringView>> rules)
+        -> bool
+    {
+        for (const auto& [suffix, replacement] : rules)
+        {
+            if (ends(suffix))
+            {
+                replace(replacement);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    auto step1ab() -> void
+    {
+        // Plurals e.g. "caresses", "ponies", "cats"
+        if (b[k] == 's')
+        {
+            if (ends("sses"))
+                k -= 2;
+            else if (ends("ies"))
+                set_to("i");
+            else if (k > 0 && b[k - 1] != 's')
+                k--;
+        }
+
+        // Past participles e.g. "agreed", "plastered", "motoring"
+        if (ends("eed"))
+        {
+            if (measure() > 0)
+                k--;
+        }
+        else if ((ends("ed") || ends("ing")) && has_vowel_in_stem())
+        {
+            k = j;
+            if (ends("at"))
+                set_to("ate");
+            else if (ends("bl"))
+                set_to("ble");
+            else if (ends("iz"))
+                set_to("ize");
+            else if (is_double_consonant(k))
+            {
+                k--;
+                if (b[k] == 'l' || b[k] == 's' || b[k] == 'z')
+                    k++;
+            }
+            else if (measure() == 1 && is_cvc(k))
+                set_to("e");
+        }
+    }
+
+    auto step1c() -> void
+    {
+        // "happy" becomes "happi"
+        if (ends("y") && has_vowel_in_stem())
+            b[k] = 'i';
+    }
+
+    auto step2() -> void
+    {
+        // Double suffixes e.g. "-ization" becomes "-ize"
+        switch (b[k - 1])
+        {
+            case 'a':
+                replace_any({{"ational", "ate"}, {"tional", "tion"}});
+                break;
+            case 'c':
+                replace_any({{"enci", "ence"}, {"anci", "ance"}});
+                break;
+            case 'e': replace_any({{"izer", "ize"}}); break;
+            case 'l':
+                replace_any({{"bli", "ble"},
+                             {"alli", "al"},
+                             {"entli", "ent"},
+                             {"eli", "e"},
+                             {"ousli", "ous"}});
+                break;
+            case 'o':
+                replace_any(
+                    {{"ization", "ize"}, {"ation", "ate"}, {"ator", "ate"}});
+                break;
+            case 's':
+                replace_any({{"alism", "al"},
+                             {"iveness", "ive"},
+                             {"fulness", "ful"},
+                             {"ousness", "ous"}});
+                break;
+            case 't':
+                replace_any(
+                    {{"aliti", "al"}, {"iviti", "ive"}, {"biliti", "ble"}});
+                break;
+            case 'g': replace_any({{"logi", "log"}}); break;
+            default: break;
+        }
+    }
+
+    auto step3() -> void
+    {
+        // "-ic-", "-full", "-ness" etc.
+        switch (b[k])
+        {
+            case 'e':
+                replace_any({{"icate", "ic"}, {"ative", ""}, {"alize", "al"}});
+                break;
+            case 'i': replace_any({{"iciti", "ic"}}); break;
+            case 'l': replace_any({{"ical", "ic"}, {"ful", ""}}); break;
+            case 's': replace_any({{"ness", ""}}); break;
+            default: break;
+        }
+    }
+
+    auto step4() -> void
+    {
+        // "-ant", "-ence" etc. in context <c>vcvc<v>
+        const auto any_of = [this](std::initializer_list<StringView> list) {
+            return std::any_of(list.begin(), list.end(),
+                               [this](StringView s) { return ends(s); });
+        };
+
+        bool found = false;
+        switch (b[k - 1])
+        {
+            case 'a': found = any_of({"al"}); break;
+            case 'c': found = any_of({"ance", "ence"}); break;
+            case 'e': found = any_of({"er"}); break;
+            case 'i': found = any_of({"ic"}); break;
+            case 'l': found = any_of({"able", "ible"}); break;
+            case 'n': found = any_of({"ant", "ement", "ment", "ent"}); break;
+            case 'o':
+                found = (ends("ion") && j >= 0 &&
+                         (b[j] == 's' || b[j] == 't')) ||
+                        any_of({"ou"});
+                break;
+            case 's': found = any_of({"ism"}); break;
+            case 't': found = any_of({"ate", "iti"}); break;
+            case 'u': found = any_of({"ous"}); break;
+            case 'v': found = any_of({"ive"}); break;
+            case 'z': found = any_of({"ize"}); break;
+            default: break;
+        }
+
+        if (found && measure() > 1)
+            k = j;
+    }
+
+    auto step5() -> void
+    {
+        // Final "-e" and "-ll"
+        j = k;
+        if (b[k] == 'e')
+        {
+            const auto m = measure();
+            if (m > 1 || (m == 1 && !is_cvc(k - 1)))
+                k--;
+        }
+
+        if (b[k] == 'l' && is_double_consonant(k) && measure() > 1)
+            k--;
+    }
+
+    StringType b;
+    int k = 0;
+    int j = 0;
+};
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// Stemmer
+//------------------------------------------------------------------------
+auto Stemmer::create(StringView /*language*/) -> StemmerPtr
+{
+    // Only English so far, other languages get their own Stemmer here
+    return std::make_shared<PorterStemmer>();
+}
+
+//------------------------------------------------------------------------
+// PorterStemmer
+//------------------------------------------------------------------------
+auto PorterStemmer::stem(StringView word) const -> StringType
+{
+    // Too short to carry a suffix
+    if (word.size() <= 2)
+        return StringType(word);
+
+    const auto is_letter = [](char c) { return c >= 'a' && c <= 'z'; };
+    if (!std::all_of(word.begin(), word.end(), is_letter))
+        return StringType(word);
+
+    return PorterAlgorithm(word).run();
+}
+
+//------------------------------------------------------------------------
+auto PorterStemmer::is_stop_word(StringView word) const -> bool
+{
+    return std::binary_search(ENGLISH_STOP_WORDS.begin(),
+                              ENGLISH_STOP_WORDS.end(), word);
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,54 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "wordify_types.h"
+#include <memory>
+#include <string_view>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// Stemmer
+//
+// Reduces a normalized word to its stem, so "recording", "recorded" and
+// "records" all become "record". Stems are only compared with each other,
+// they need not be real words. Also knows the stop words of its language.
+// One implementation per language.
+//------------------------------------------------------------------------
+class Stemmer
+{
+public:
+    //--------------------------------------------------------------------
+    using StringView = std::string_view;
+    using StemmerPtr = std::shared_ptr<const Stemmer>;
+
+    virtual ~Stemmer() = default;
+
+    /** The word must be normalized already, see text_normalizer */
+    virtual auto stem(StringView word) const -> StringType = 0;
+
+    /** Frequent words carrying little meaning, like "the" or "and". The
+     *  word must be normalized already. */
+    virtual auto is_stop_word(StringView word) const -> bool = 0;
+
+    /** Stemmer of an ISO 639-1 language code, English for unknown ones */
+    static auto create(StringView language) -> StemmerPtr;
+};
+
+//------------------------------------------------------------------------
+// PorterStemmer
+//
+// English suffix stripping after M.F. Porter (1980). Words containing
+// anything but the letters a to z are left alone.
+//------------------------------------------------------------------------
+class PorterStemmer final : public Stemmer
+{
+public:
+    //--------------------------------------------------------------------
+    auto stem(StringView word) const -> StringType override;
+    auto is_stop_word(StringView word) const -> bool override;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -3,8 +3,12 @@
 //------------------------------------------------------------------------
 
 #include "string_matcher.h"
+#include "double_metaphone.h"
+#include "stemmer.h"
 #include <algorithm>
-#include <cctype>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace mam {
@@ -19,78 +23,219 @@ enum class FuzzyMatchStyle
 };
 
 //------------------------------------------------------------------------
-void prepareStrings(StringType& toMatch, StringType& string)
+bool isDirectMatch(std::string_view toMatch, std::string_view string)
 {
-    std::transform(toMatch.begin(), toMatch.end(), toMatch.begin(), ::tolower);
-    std::transform(string.begin(), string.end(), string.begin(), ::tolower);
-
-    toMatch.erase(
-        std::remove_if(
-            toMatch.begin(), toMatch.end(),
-            [](char c) { return std::ispunct(static_cast<unsigned char>(c)); }),
-        toMatch.end());
+    return toMatch == string;
 }
 
 //------------------------------------------------------------------------
-bool isDirectMatch(StringType toMatch, StringType string)
+bool isSubMatch(std::string_view toMatch, std::string_view string)
 {
-    if (toMatch.length() != string.length())
-        return false;
+    return toMatch.find(string) != std::string_view::npos;
+}
+
+//------------------------------------------------------------------------
+bool isFuzzyMatch(std::string_view toMatch,
+                  std::string_view string,
+                  FuzzyMatchStyle style)
+{
+    if (style == FuzzyMatchStyle::nearbyFuzzy)
+        return boundedEditDistance(toMatch, string, NEARBY_FUZZY_DISTANCE)
+            .has_value();
+    else if (style == FuzzyMatchStyle::intermediateFuzzy)
+        return boundedEditDistance(toMatch, string,
+                                   INTERMEDIATE_FUZZY_DISTANCE)
+            .has_value();
 
-    return (toMatch == string);
+    return false;
 }
 
 //------------------------------------------------------------------------
-bool isSubMatch(StringType toMatch, StringType string)
+bool isPhoneticMatch(std::string_view toMatch, std::string_view string)
 {
-    return std::search(toMatch.begin(), toMatch.end(), string.begin(),
-                       string.end()) != toMatch.end();
+    return double_metaphone::is_match(double_metaphone::encode(toMatch),
+                                      double_metaphone::encode(string));
 }
 
 //------------------------------------------------------------------------
-bool isFuzzyMatch(StringType toMatch, StringType string, FuzzyMatchStyle style)
+bool isStemMatch(std::string_view toMatch,
+                 std::string_view string,
+                 const Stemmer& stemmer)
 {
-    size_t x = toMatch.length();
-    size_t y = string.length();
+    return stemmer.stem(toMatch) == stemmer.stem(string);
+}
+
+//------------------------------------------------------------------------
+constexpr size_t MAX_BIT_PARALLEL_LENGTH = 64;
+
+//------------------------------------------------------------------------
+// Bit-parallel Levenshtein distance after Myers (1999) in the formulation of
+// Hyyrö (2001). One machine word holds a whole DP column of the pattern,
+// which must not be longer than 64 bytes. No allocations at all.
+Distance bitParallelEditDistance(std::string_view pattern,
+                                 std::string_view text,
+                                 Distance maxDistance)
+{
+    const auto m = pattern.length();
+    if (m == 0)
+        return text.length();
+
+    std::array<uint64_t, 256> peq{};
+    for (size_t i = 0; i < m; ++i)
+        peq[static_cast<unsigned char>(pattern[i])] |= uint64_t(1) << i;
+
+    const uint64_t last = uint64_t(1) << (m - 1);
+    uint64_t pv         = ~uint64_t(0);
+    uint64_t mv         = 0;
+    Distance score      = m;
+    for (size_t j = 0; j < text.length(); ++j)
+    {
+        const auto eq = peq[static_cast<unsigned char>(text[j])];
+        const auto xv = eq | mv;
+        const auto xh = (((eq & pv) + pv) ^ pv) | eq;
+        auto ph       = mv | ~(xh | pv);
+        auto mh       = pv & xh;
+
+        if (ph & last)
+            ++score;
+        else if (mh & last)
+            --score;
+
+        // The score drops by at most one per remaining text byte
+        const auto remaining = text.length() - j - 1;
+        if (score > maxDistance + remaining)
+            return score - remaining;
+
+        ph = (ph << 1) | 1;
+        mh = mh << 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
 
+    return score;
+}
 
-    std::vector<std::vector<int>> distanceVector(x + 1,
-                                                 std::vector<int>(y + 1, 0));
+//------------------------------------------------------------------------
+// Ukkonen's banded DP for strings too long for the bit-parallel kernel. Only
+// cells within maxDistance of the diagonal can stay below the threshold.
+OptDistance bandedEditDistance(std::string_view s0,
+                               std::string_view s1,
+                               Distance maxDistance)
+{
+    const auto n        = s0.length();
+    const auto m        = s1.length();
+    const auto infinity = maxDistance + 1;
 
-    for (size_t i = 0; i <= x; ++i)
-        distanceVector[i][0] = static_cast<int>(i);
-    for (size_t j = 0; j <= y; ++j)
-        distanceVector[0][j] =  static_cast<int>(j);
+    std::vector<Distance> prev(m + 1, infinity);
+    std::vector<Distance> curr(m + 1, infinity);
+    for (size_t j = 0; j <= std::min(m, maxDistance); ++j)
+        prev[j] = j;
 
-    for (size_t i = 1; i <= x; ++i)
+    for (size_t i = 1; i <= n; ++i)
     {
-        for (size_t j = 1; j <= y; ++j)
+        const auto jlo = i > maxDistance ? i - maxDistance : 1;
+        const auto jhi = std::min(m, i + maxDistance);
+
+        curr[jlo - 1]   = jlo == 1 ? std::min(i, infinity) : infinity;
+        auto rowMinimum = curr[jlo - 1];
+        for (size_t j = jlo; j <= jhi; ++j)
         {
-            if (toMatch[i - 1] == string[j - 1])
-                distanceVector[i][j] = distanceVector[i - 1][j - 1];
+            if (s0[i - 1] == s1[j - 1])
+                curr[j] = prev[j - 1];
             else
-                distanceVector[i][j] =
-                    std::min({distanceVector[i - 1][j],
-                              distanceVector[i][j - 1],
-                              distanceVector[i - 1][j - 1]}) +
-                    1;
+                curr[j] = std::min({prev[j], curr[j - 1], prev[j - 1]}) + 1;
+
+            curr[j]    = std::min(curr[j], infinity);
+            rowMinimum = std::min(rowMinimum, curr[j]);
         }
+
+        if (jhi < m)
+            curr[jhi + 1] = infinity;
+
+        if (rowMinimum > maxDistance)
+            return std::nullopt;
+
+        std::swap(prev, curr);
     }
 
-    int result = distanceVector[x][y];
+    if (prev[m] > maxDistance)
+        return std::nullopt;
 
-    if (style == FuzzyMatchStyle::nearbyFuzzy)
-        return result <= 1;
-    else if (style == FuzzyMatchStyle::intermediateFuzzy)
-        return result <= 2;
+    return prev[m];
+}
 
-    return false;
+//------------------------------------------------------------------------
+Distance editDistance(std::string_view s0, std::string_view s1)
+{
+    if (s0.length() < s1.length())
+        std::swap(s0, s1);
+
+    constexpr auto NO_LIMIT = std::numeric_limits<Distance>::max() / 2;
+    if (s1.length() <= MAX_BIT_PARALLEL_LENGTH)
+        return bitParallelEditDistance(s1, s0, NO_LIMIT);
+
+    // Two rows of the DP matrix are enough, the shorter string spans them
+    std::vector<Distance> prev(s1.length() + 1);
+    std::vector<Distance> curr(s1.length() + 1);
+    for (size_t j = 0; j <= s1.length(); ++j)
+        prev[j] = j;
+
+    for (size_t i = 1; i <= s0.length(); ++i)
+    {
+        curr[0] = i;
+        for (size_t j = 1; j <= s1.length(); ++j)
+        {
+            if (s0[i - 1] == s1[j - 1])
+                curr[j] = prev[j - 1];
+            else
+                curr[j] = std::min({prev[j], curr[j - 1], prev[j - 1]}) + 1;
+        }
+
+        std::swap(prev, curr);
+    }
+
+    return prev[s1.length()];
+}
+
+//------------------------------------------------------------------------
+OptDistance boundedEditDistance(std::string_view s0,
+                                std::string_view s1,
+                                Distance maxDistance)
+{
+    if (s0.length() < s1.length())
+        std::swap(s0, s1);
+
+    // Every byte of the length difference costs one insertion at least
+    if (s0.length() - s1.length() > maxDistance)
+        return std::nullopt;
+
+    if (s1.length() > MAX_BIT_PARALLEL_LENGTH)
+        return bandedEditDistance(s0, s1, maxDistance);
+
+    const auto distance = bitParallelEditDistance(s1, s0, maxDistance);
+    if (distance > maxDistance)
+        return std::nullopt;
+
+    return distance;
 }
 
 //------------------------------------------------------------------------
-bool isMatch(StringType toMatch, StringType string, MatchMethod method)
+OptDistance maxEditDistance(MatchMethod method)
+{
+    if (method == MatchMethod::nearbyFuzzyMatch)
+        return NEARBY_FUZZY_DISTANCE;
+    else if (method == MatchMethod::intermediateFuzzyMatch)
+        return INTERMEDIATE_FUZZY_DISTANCE;
+
+    return std::nullopt;
+}
+
+//------------------------------------------------------------------------
+bool isMatch(std::string_view toMatch,
+             std::string_view string,
+             MatchMethod method,
+             const Stemmer* stemmer)
 {
-    prepareStrings(toMatch, string);
     if (method == MatchMethod::directMatch)
         return isDirectMatch(toMatch, string);
     else if (method == MatchMethod::subMatch)
@@ -100,6 +245,13 @@ bool isMatch(StringType toMatch, StringType string, MatchMethod method)
     else if (method == MatchMethod::intermediateFuzzyMatch)
         return isFuzzyMatch(toMatch, string,
                             FuzzyMatchStyle::intermediateFuzzy);
+    else if (method == MatchMethod::phoneticMatch)
+        return isPhoneticMatch(toMatch, string);
+    else if (method == MatchMethod::stemMatch)
+    {
+        static const auto english = Stemmer::create("en");
+        return isStemMatch(toMatch, string, stemmer ? *stemmer : *english);
+    }
 
     return false;
 }
@@ -5,8 +5,11 @@
 #pragma once
 
 #include "wordify_types.h"
+#include <optional>
+#include <string_view>
 
 namespace mam {
+class Stemmer;
 
 //------------------------------------------------------------------------
 // StringMatcher
@@ -17,11 +20,40 @@ enum class MatchMethod
     directMatch,
     subMatch,
     nearbyFuzzyMatch,
-    intermediateFuzzyMatch
+    intermediateFuzzyMatch,
+    phoneticMatch,
+    stemMatch
 
 };
 
-bool isMatch(StringType toMatch, StringType string, MatchMethod method);
+using Distance    = size_t;
+using OptDistance = std::optional<Distance>;
+
+// Maximum edit distances of the fuzzy match methods
+constexpr Distance NEARBY_FUZZY_DISTANCE       = 1;
+constexpr Distance INTERMEDIATE_FUZZY_DISTANCE = 2;
+
+/** Both strings must be normalized already, see text_normalizer. Stemmed
+ *  matches use the stemmer of the SearchIndex, if given, so scanning finds
+ *  the same words as the index. English otherwise.
+ */
+bool isMatch(std::string_view toMatch,
+             std::string_view string,
+             MatchMethod method,
+             const Stemmer* stemmer = nullptr);
+
+/** Levenshtein distance of the raw bytes */
+Distance editDistance(std::string_view s0, std::string_view s1);
+
+/** Levenshtein distance if it is not larger than maxDistance, none
+ *  otherwise. Gives up as soon as maxDistance can not be met anymore.
+ */
+OptDistance boundedEditDistance(std::string_view s0,
+                                std::string_view s1,
+                                Distance maxDistance);
+
+/** Maximum edit distance of a fuzzy match method, none for all others */
+OptDistance maxEditDistance(MatchMethod method);
 
 }; // namespace StringMatcher
 
@@ -15,37 +15,6 @@ END_SUPPRESS_WARNINGS
 namespace mam::task_managing {
 namespace {
 
-//------------------------------------------------------------------------
-auto create_whisper_cmd(const meta_words::PathType& file_path)
-    -> const meta_words::Command
-{
-    using Options    = const meta_words::Options;
-    using OneValArgs = const meta_words::OneValArgs;
-    using Command    = const meta_words::Command;
-
-    //  The whisper.cpp library takes the audio file and writes the result
-    //  of its analysis into a CSV file. The file is named like the audio
-    //  file and by prepending ".csv" e.g. my_speech.wav ->
-    //  my_speech.wav.csv
-    Options options = {"-ocsv" /* output result in a CSV file */,
-                       "-sow" /* split on word rather than on token */};
-
-    OneValArgs one_val_args = {
-        // model file resp. binary
-        {"-m", whisper_cpp::get_ggml_file_path()},
-        // audio file to analyse
-        {"-f", file_path},
-        // maximum segment length in characters: "1" mains one word
-        {"-ml", "1"},
-        // auto language detection
-        {"-l", "auto"}};
-
-    Command cmd{whisper_cpp::get_worker_executable_path(), options,
-                one_val_args};
-
-    return cmd;
-}
-
 //------------------------------------------------------------------------
 using OptionalId   = std::optional<Id>;
 using AtomicBool   = std::atomic_bool;
@@ -244,7 +213,8 @@ auto TaskManager::assign_next_tasks() -> void
             auto cancel_func   = [&]() { return worker.is_canceled.load(); };
 
             const auto cmd =
-                create_whisper_cmd(worker.optional_task.value().input_data);
+                whisper_cpp::create_command(
+                    worker.optional_task.value().input_data);
             return meta_words::run(cmd, std::move(progress_func),
                                    std::move(cancel_func));
         });
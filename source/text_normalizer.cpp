@@ -0,0 +1,231 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "text_normalizer.h"
+#include <cctype>
+
+namespace mam::text_normalizer {
+namespace {
+
+//------------------------------------------------------------------------
+struct CodePoint
+{
+    char32_t value = 0;
+    size_t length  = 0; // 0 for an invalid sequence
+};
+
+//------------------------------------------------------------------------
+auto decode(StringView text, size_t pos) -> CodePoint
+{
+    const auto byte = [&](size_t i) {
+        return static_cast<unsigned char>(text[pos + i]);
+    };
+
+    const auto lead = byte(0);
+    if (lead < 0x80)
+        return {lead, 1};
+
+    size_t length = 0;
+    if ((lead & 0xE0) == 0xC0)
+        length = 2;
+    else if ((lead & 0xF0) == 0xE0)
+        length = 3;
+    else if ((lead & 0xF8) == 0xF0)
+        length = 4;
+    else
+        return {};
+
+    // Payload bits of the lead byte
+    char32_t value = lead & (0x7F >> length);
+
+    if (pos + length > text.size())
+        return {};
+
+    for (size_t i = 1; i < length; i++)
+    {
+        if ((byte(i) & 0xC0) != 0x80)
+            return {};
+
+        value = (value << 6) | (byte(i) & 0x3F);
+    }
+
+    return {value, length};
+}
+
+//------------------------------------------------------------------------
+auto encode(char32_t value, StringType& out) -> void
+{
+    if (value < 0x80)
+    {
+        out.push_back(static_cast<char>(value));
+    }
+    else if (value < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (value >> 6)));
+        out.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+    }
+    else if (value < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (value >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((value >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (value >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((value >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((value >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+    }
+}
+
+//------------------------------------------------------------------------
+constexpr auto in_range(char32_t cp, char32_t first, char32_t last) -> bool
+{
+    return first <= cp && cp <= last;
+}
+
+//------------------------------------------------------------------------
+// Blocks where upper and lower case letters alternate
+constexpr auto fold_even_upper(char32_t cp) -> char32_t
+{
+    return cp | 1;
+}
+
+constexpr auto fold_odd_upper(char32_t cp) -> char32_t
+{
+    return (cp & 1) ? cp + 1 : cp;
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+auto fold_case(char32_t cp) -> char32_t
+{
+    if (cp < 0x80)
+        return in_range(cp, 'A', 'Z') ? cp + 0x20 : cp;
+
+    // Latin-1 Supplement and Latin Extended-A
+    if (in_range(cp, 0xC0, 0xDE) && cp != 0xD7)
+        return cp + 0x20;
+    if (cp == 0x130) // Capital I with dot above
+        return 'i';
+    if (in_range(cp, 0x100, 0x137) || in_range(cp, 0x14A, 0x177))
+        return fold_even_upper(cp);
+    if (in_range(cp, 0x139, 0x148) || in_range(cp, 0x179, 0x17E))
+        return fold_odd_upper(cp);
+    if (cp == 0x178)
+        return 0xFF;
+
+    // Greek
+    if (cp == 0x386)
+        return 0x3AC;
+    if (in_range(cp, 0x388, 0x38A))
+        return cp + 0x25;
+    if (cp == 0x38C)
+        return 0x3CC;
+    if (in_range(cp, 0x38E, 0x38F))
+        return cp + 0x3F;
+    if (in_range(cp, 0x391, 0x3AB) && cp != 0x3A2)
+        return cp + 0x20;
+    if (cp == 0x3C2) // Final sigma
+        return 0x3C3;
+
+    // Cyrillic
+    if (in_range(cp, 0x400, 0x40F))
+        return cp + 0x50;
+    if (in_range(cp, 0x410, 0x42F))
+        return cp + 0x20;
+    if (in_range(cp, 0x460, 0x481) || in_range(cp, 0x48A, 0x4BF) ||
+        in_range(cp, 0x4D0, 0x4FF))
+        return fold_even_upper(cp);
+
+    // Armenian
+    if (in_range(cp, 0x531, 0x556))
+        return cp + 0x30;
+
+    // Latin Extended Additional, e.g. Vietnamese
+    if (cp == 0x1E9E) // Capital sharp s
+        return 0xDF;
+    if (in_range(cp, 0x1E00, 0x1E95) || in_range(cp, 0x1EA0, 0x1EFF))
+        return fold_even_upper(cp);
+
+    // Fullwidth Latin
+    if (in_range(cp, 0xFF21, 0xFF3A))
+        return cp + 0x20;
+
+    return cp;
+}
+
+//------------------------------------------------------------------------
+auto is_punctuation(char32_t cp) -> bool
+{
+    if (cp < 0x80)
+        return std::ispunct(static_cast<int>(cp)) != 0;
+
+    switch (cp)
+    {
+        case 0xA1:  // Inverted exclamation mark
+        case 0xA7:  // Section sign
+        case 0xAB:  // Left guillemet
+        case 0xB6:  // Pilcrow
+        case 0xB7:  // Middle dot
+        case 0xBB:  // Right guillemet
+        case 0xBF:  // Inverted question mark
+        case 0x589: // Armenian full stop
+        case 0x5BE: // Hebrew maqaf
+        case 0x5C0:
+        case 0x5C3:
+        case 0x5C6:
+        case 0x60C: // Arabic comma
+        case 0x61B: // Arabic semicolon
+        case 0x61F: // Arabic question mark
+        case 0x964: // Devanagari danda
+        case 0x965:
+        case 0xE4F: // Thai
+        case 0xE5A:
+        case 0xE5B: return true;
+        default: break;
+    }
+
+    return in_range(cp, 0x55A, 0x55F) ||   // Armenian
+           in_range(cp, 0x5F3, 0x5F4) ||   // Hebrew
+           in_range(cp, 0x66A, 0x66D) ||   // Arabic
+           in_range(cp, 0x2010, 0x2027) || // General Punctuation
+           in_range(cp, 0x2030, 0x205E) ||
+           in_range(cp, 0x3001, 0x3003) || // CJK Symbols and Punctuation
+           in_range(cp, 0x3008, 0x301F) ||
+           in_range(cp, 0xFF01, 0xFF0F) || // Fullwidth forms
+           in_range(cp, 0xFF1A, 0xFF20) ||
+           in_range(cp, 0xFF3B, 0xFF40) ||
+           in_range(cp, 0xFF5B, 0xFF65);
+}
+
+//------------------------------------------------------------------------
+auto normalize(StringView text) -> StringType
+{
+    StringType normalized;
+    normalized.reserve(text.size());
+
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        const auto code_point = decode(text, pos);
+        if (code_point.length == 0)
+        {
+            normalized.push_back(text[pos++]);
+            continue;
+        }
+
+        pos += code_point.length;
+        if (is_punctuation(code_point.value))
+            continue;
+
+        encode(fold_case(code_point.value), normalized);
+    }
+
+    return normalized;
+}
+
+//------------------------------------------------------------------------
+} // namespace mam::text_normalizer
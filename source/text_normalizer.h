@@ -0,0 +1,25 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "wordify_types.h"
+#include <string_view>
+
+namespace mam::text_normalizer {
+//------------------------------------------------------------------------
+// Transcript words and search queries are compared in normalized form only:
+// case folded and without punctuation. Whisper runs with '-l auto', so
+// normalization works on UTF-8 code points, not on bytes. Invalid UTF-8
+// bytes are passed through unchanged.
+//------------------------------------------------------------------------
+using StringView = std::string_view;
+
+/** Simple case folding of Latin, Greek, Cyrillic and Armenian letters */
+auto fold_case(char32_t code_point) -> char32_t;
+auto is_punctuation(char32_t code_point) -> bool;
+
+/** Case folded and without punctuation */
+auto normalize(StringView text) -> StringType;
+
+//------------------------------------------------------------------------
+} // namespace mam::text_normalizer
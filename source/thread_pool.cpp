@@ -0,0 +1,70 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// ThreadPool
+//------------------------------------------------------------------------
+ThreadPool::ThreadPool(size_t num_threads)
+: num_threads(std::max<size_t>(num_threads, 1))
+{
+}
+
+//------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        is_stopping = true;
+        tasks.clear();
+    }
+
+    condition.notify_all();
+    for (auto& thread : threads)
+        thread.join();
+}
+
+//------------------------------------------------------------------------
+auto ThreadPool::post(Task&& task) -> void
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (threads.empty())
+        {
+            for (size_t i = 0; i < num_threads; i++)
+                threads.emplace_back([this]() { run(); });
+        }
+
+        tasks.push_back(std::move(task));
+    }
+
+    condition.notify_one();
+}
+
+//------------------------------------------------------------------------
+auto ThreadPool::run() -> void
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock,
+                           [this]() { return is_stopping || !tasks.empty(); });
+
+            if (is_stopping)
+                return;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,141 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// ThreadPool
+//
+// Fixed number of worker threads draining one queue of tasks in the order
+// they were posted. The threads are only started with the first task and
+// live until the pool is destroyed, so posting never creates a thread.
+// Tasks must not throw, the destructor drops tasks which did not start yet
+// and waits for the running ones.
+//------------------------------------------------------------------------
+class ThreadPool
+{
+public:
+    //--------------------------------------------------------------------
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)                    = delete;
+    auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+    auto post(Task&& task) -> void;
+    auto size() const -> size_t { return num_threads; }
+
+    //--------------------------------------------------------------------
+private:
+    auto run() -> void;
+
+    const size_t num_threads;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Task> tasks;
+    bool is_stopping = false;
+};
+
+//------------------------------------------------------------------------
+/** Runs find(i) for all items on the threads of the pool, but hands the
+ *  results to consume(i, result) in order of i and on the calling thread.
+ *  Stops early once consume() returns false. An exception thrown by find()
+ *  is rethrown on the calling thread once all workers are done.
+ */
+template <typename Result, typename Find, typename Consume>
+auto for_each_in_order(ThreadPool& pool,
+                       size_t count,
+                       const Find& find,
+                       const Consume& consume) -> void
+{
+    struct Item
+    {
+        std::optional<Result> result;
+        std::exception_ptr error;
+        bool is_done = false;
+    };
+
+    std::vector<Item> items(count);
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<size_t> next_item{0};
+    std::atomic<bool> is_stopped{false};
+    size_t count_running = std::min(pool.size(), count);
+
+    const auto work = [&]() {
+        for (auto i = next_item++; i < count && !is_stopped; i = next_item++)
+        {
+            Item item;
+            try
+            {
+                item.result = find(i);
+            }
+            catch (...)
+            {
+                item.error = std::current_exception();
+            }
+
+            item.is_done = true;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                items[i] = std::move(item);
+            }
+            condition.notify_all();
+        }
+
+        // The locals of for_each_in_order must outlive the last worker
+        std::lock_guard<std::mutex> lock(mutex);
+        count_running--;
+        condition.notify_all();
+    };
+
+    const auto num_workers = count_running;
+    for (size_t t = 0; t < num_workers; t++)
+        pool.post(work);
+
+    const auto wait_for_workers = [&]() {
+        is_stopped = true;
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return count_running == 0; });
+    };
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Item item;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&]() { return items[i].is_done; });
+            item = std::move(items[i]);
+        }
+
+        if (item.error)
+        {
+            wait_for_workers();
+            std::rethrow_exception(item.error);
+        }
+
+        if (!consume(i, std::move(*item.result)))
+            break;
+    }
+
+    wait_for_workers();
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,88 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "timeline_index.h"
+
+namespace mam {
+namespace {
+
+//------------------------------------------------------------------------
+auto begin_less(const TimelineIndex::Entry& lhs,
+                const TimelineIndex::Entry& rhs) -> bool
+{
+    return lhs.begin < rhs.begin;
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// TimelineIndex
+//------------------------------------------------------------------------
+auto TimelineIndex::update_region(Id region_id, Entries&& region_entries)
+    -> void
+{
+    remove_region(region_id);
+    if (region_entries.empty())
+        return;
+
+    std::sort(region_entries.begin(), region_entries.end(), begin_less);
+    for (auto& entry : region_entries)
+    {
+        entry.region_id = region_id;
+        max_duration    = std::max(max_duration, entry.end - entry.begin);
+    }
+
+    // Merge the sorted region entries into the sorted index instead of
+    // sorting everything again
+    const auto middle = static_cast<Entries::difference_type>(entries.size());
+    entries.insert(entries.end(), region_entries.begin(),
+                   region_entries.end());
+    std::inplace_merge(entries.begin(), entries.begin() + middle,
+                       entries.end(), begin_less);
+}
+
+//------------------------------------------------------------------------
+auto TimelineIndex::remove_region(Id region_id) -> void
+{
+    const auto iter = std::remove_if(
+        entries.begin(), entries.end(), [region_id](const auto& entry) {
+            return entry.region_id == region_id;
+        });
+
+    entries.erase(iter, entries.end());
+}
+
+//------------------------------------------------------------------------
+auto TimelineIndex::clear() -> void
+{
+    entries.clear();
+    max_duration = 0.;
+}
+
+//------------------------------------------------------------------------
+auto TimelineIndex::find_at(Seconds time) const -> Entries
+{
+    Entries found;
+    for_each_at(time, [&](const Entry& entry) { found.push_back(entry); });
+    return found;
+}
+
+//------------------------------------------------------------------------
+auto TimelineIndex::find_in(Seconds start, Seconds end) const -> Entries
+{
+    Entries found;
+    for_each_in(start, end,
+                [&](const Entry& entry) { found.push_back(entry); });
+    return found;
+}
+
+//------------------------------------------------------------------------
+auto TimelineIndex::lower_bound(Seconds time) const -> Iterator
+{
+    return std::lower_bound(
+        entries.begin(), entries.end(), time,
+        [](const Entry& entry, Seconds value) { return entry.begin < value; });
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
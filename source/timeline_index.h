@@ -0,0 +1,96 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "wordify_types.h"
+#include <algorithm>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// TimelineIndex
+//
+// Maps project time to the words of all playback regions. Entries are kept
+// sorted by their begin in project time, so point and range queries run in
+// O(log n + k). A region's entries are replaced as a whole whenever the
+// region or its transcript changes, all other regions stay untouched.
+//------------------------------------------------------------------------
+class TimelineIndex
+{
+public:
+    //--------------------------------------------------------------------
+    using Seconds = double;
+
+    struct Entry
+    {
+        Seconds begin    = 0.; // in project time
+        Seconds end      = 0.; // in project time
+        Id region_id     = 0;
+        Index word_index = 0;
+    };
+
+    using Entries = std::vector<Entry>;
+
+    /** Replaces all entries of the region. Entries must be in project time,
+     *  they do not need to be sorted. */
+    auto update_region(Id region_id, Entries&& entries) -> void;
+    auto remove_region(Id region_id) -> void;
+    auto clear() -> void;
+
+    /** Calls func(const Entry&) for each word spoken at 'time' */
+    template <typename Func>
+    auto for_each_at(Seconds time, Func&& func) const -> void;
+
+    /** Calls func(const Entry&) for each word overlapping [start, end) */
+    template <typename Func>
+    auto for_each_in(Seconds start, Seconds end, Func&& func) const -> void;
+
+    auto find_at(Seconds time) const -> Entries;
+    auto find_in(Seconds start, Seconds end) const -> Entries;
+    auto size() const -> size_t { return entries.size(); }
+    auto empty() const -> bool { return entries.empty(); }
+
+    //--------------------------------------------------------------------
+private:
+    using Iterator = Entries::const_iterator;
+
+    auto lower_bound(Seconds time) const -> Iterator;
+
+    Entries entries;
+    // Longest word, words beginning earlier than 'time - max_duration' can
+    // not overlap 'time' anymore.
+    Seconds max_duration = 0.;
+};
+
+//------------------------------------------------------------------------
+template <typename Func>
+inline auto TimelineIndex::for_each_at(Seconds time, Func&& func) const -> void
+{
+    const auto last = std::upper_bound(
+        entries.begin(), entries.end(), time,
+        [](Seconds value, const Entry& entry) { return value < entry.begin; });
+
+    for (auto iter = lower_bound(time - max_duration); iter != last; ++iter)
+    {
+        if (time < iter->end)
+            func(*iter);
+    }
+}
+
+//------------------------------------------------------------------------
+template <typename Func>
+inline auto
+TimelineIndex::for_each_in(Seconds start, Seconds end, Func&& func) const
+    -> void
+{
+    const auto last = lower_bound(end);
+    for (auto iter = lower_bound(start - max_duration); iter < last; ++iter)
+    {
+        if (start < iter->end)
+            func(*iter);
+    }
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,81 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "trigram_index.h"
+#include <algorithm>
+#include <iterator>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// TrigramIndex
+//------------------------------------------------------------------------
+auto TrigramIndex::add(TermId term_id, StringView term) -> void
+{
+    for (size_t pos = 0; pos + GRAM_SIZE <= term.size(); pos++)
+    {
+        // A trigram can occur more than once in a term e.g. "aaaa"
+        auto& term_ids = postings[make_key(term, pos)];
+        if (term_ids.empty() || term_ids.back() != term_id)
+            term_ids.push_back(term_id);
+    }
+}
+
+//------------------------------------------------------------------------
+auto TrigramIndex::find_candidates(StringView query) const -> TermIds
+{
+    if (query.size() < GRAM_SIZE)
+        return {};
+
+    std::vector<const TermIds*> lists;
+    for (size_t pos = 0; pos + GRAM_SIZE <= query.size(); pos++)
+    {
+        const auto iter = postings.find(make_key(query, pos));
+        if (iter == postings.end())
+            return {};
+
+        lists.push_back(&iter->second);
+    }
+
+    // Intersect starting with the shortest list, keeps the result small
+    std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) {
+        return a->size() < b->size();
+    });
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+    TermIds candidates = *lists.front();
+    TermIds intersection;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); i++)
+    {
+        intersection.clear();
+        std::set_intersection(candidates.begin(), candidates.end(),
+                              lists[i]->begin(), lists[i]->end(),
+                              std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    return candidates;
+}
+
+//------------------------------------------------------------------------
+auto TrigramIndex::memory_usage() const -> size_t
+{
+    size_t bytes = sizeof(TrigramIndex);
+    for (const auto& entry : postings)
+        bytes += sizeof(entry) + sizeof(void*) +
+                 entry.second.capacity() * sizeof(TermId);
+
+    bytes += postings.bucket_count() * sizeof(void*);
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------
+auto TrigramIndex::make_key(StringView text, size_t pos) -> Key
+{
+    return static_cast<Key>(static_cast<unsigned char>(text[pos])) << 16 |
+           static_cast<Key>(static_cast<unsigned char>(text[pos + 1])) << 8 |
+           static_cast<Key>(static_cast<unsigned char>(text[pos + 2]));
+}
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -0,0 +1,48 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mam {
+
+//------------------------------------------------------------------------
+// TrigramIndex
+//
+// Maps every 3 byte substring (trigram) of the vocabulary terms to the
+// ascending ids of the terms containing it. A term contains a query only if
+// it contains all of the query's trigrams, so intersecting their lists gives
+// a small set of candidates which still need to be verified.
+//------------------------------------------------------------------------
+class TrigramIndex
+{
+public:
+    //--------------------------------------------------------------------
+    using TermId     = uint32_t;
+    using TermIds    = std::vector<TermId>;
+    using StringView = std::string_view;
+
+    static constexpr size_t GRAM_SIZE = 3;
+
+    /** Terms must be added with ascending ids */
+    auto add(TermId term_id, StringView term) -> void;
+
+    /** Query must be at least GRAM_SIZE bytes long */
+    auto find_candidates(StringView query) const -> TermIds;
+    auto memory_usage() const -> size_t;
+
+    //--------------------------------------------------------------------
+private:
+    using Key      = uint32_t;
+    using Postings = std::unordered_map<Key, TermIds>;
+
+    static auto make_key(StringView text, size_t pos) -> Key;
+
+    Postings postings;
+};
+
+//------------------------------------------------------------------------
+} // namespace mam
@@ -23,6 +23,19 @@ auto drawBackground(CDrawContext* context,
         context->drawGraphicsPath(path);
 }
 
+//------------------------------------------------------------------------
+auto drawUnderline(CDrawContext* context,
+                   const CRect& rect,
+                   const CColor color) -> void
+{
+    static constexpr CCoord LINE_WIDTH = 2.;
+
+    context->setFillColor(color);
+    context->drawRect(
+        CRect(rect.left, rect.bottom - LINE_WIDTH, rect.right, rect.bottom),
+        kDrawFilled);
+}
+
 //------------------------------------------------------------------------
 } // namespace
 
@@ -48,6 +61,9 @@ void WordButton::draw(CDrawContext* context)
     }
 
     CTextButton::draw(context);
+
+    if (playhead)
+        drawUnderline(context, getViewSize(), playheadColor);
 }
 
 //------------------------------------------------------------------------
@@ -88,6 +104,15 @@ bool WordButton::setState(State new_state)
     return changed;
 }
 
+//------------------------------------------------------------------------
+bool WordButton::setPlayhead(bool is_playhead)
+{
+    const bool changed = playhead != is_playhead;
+    playhead           = is_playhead;
+
+    return changed;
+}
+
 //------------------------------------------------------------------------
 void WordButton::verifyTextButtonView(const VSTGUI::IUIDescription* description)
 {
@@ -96,6 +121,7 @@ void WordButton::verifyTextButtonView(const VSTGUI::IUIDescription* description)
     description->getColor("search_select_hilite_bgr_color", focusedBgrColor);
     description->getColor("search_select_hilite_text_color", focusedTextColor);
     description->getColor("transcript_text_color", normalTextColor);
+    description->getColor("playhead_hilite_color", playheadColor);
 }
 
 //------------------------------------------------------------------------
@@ -35,6 +35,9 @@ public:
 
     void draw(VSTGUI::CDrawContext* context) override;
     bool setState(State state);
+    /** Marks the word currently under the playhead, independent of its
+     * search state. */
+    bool setPlayhead(bool is_playhead);
     void verifyTextButtonView(const VSTGUI::IUIDescription* description);
 
     //--------------------------------------------------------------------
@@ -45,7 +48,9 @@ private:
     VSTGUI::CColor focusedTextColor  = VSTGUI::kBlackCColor;
     VSTGUI::CColor normalTextColor   = VSTGUI::kBlackCColor;
     VSTGUI::CColor currentBgrColor   = VSTGUI::kTransparentCColor;
+    VSTGUI::CColor playheadColor     = VSTGUI::kBlueCColor;
     State state                      = State::kNone;
+    bool playhead                    = false;
 };
 
 //------------------------------------------------------------------------
@@ -66,6 +66,42 @@ auto get_ggml_file_path() -> PathType
     return get_ggml_file_path(COMPANY_NAME_STR, PLUGIN_NAME_STR);
 }
 
+//------------------------------------------------------------------------
+auto get_language() -> StringType
+{
+    // Auto detection, the detected language is not reported back
+    return "auto";
+}
+
+//------------------------------------------------------------------------
+auto create_command(const PathType& file_path) -> const meta_words::Command
+{
+    using Options    = const meta_words::Options;
+    using OneValArgs = const meta_words::OneValArgs;
+    using Command    = const meta_words::Command;
+
+    //  The whisper.cpp library takes the audio file and writes the result
+    //  of its analysis into a CSV file. The file is named like the audio
+    //  file and by prepending ".csv" e.g. my_speech.wav ->
+    //  my_speech.wav.csv
+    Options options = {"-ocsv" /* output result in a CSV file */,
+                       "-sow" /* split on word rather than on token */};
+
+    OneValArgs one_val_args = {
+        // model file resp. binary
+        {"-m", get_ggml_file_path()},
+        // audio file to analyse
+        {"-f", file_path},
+        // maximum segment length in characters: "1" mains one word
+        {"-ml", "1"},
+        // transcription language
+        {"-l", get_language()}};
+
+    Command cmd{get_worker_executable_path(), options, one_val_args};
+
+    return cmd;
+}
+
 //------------------------------------------------------------------------
 
 } // namespace mam::whisper_cpp
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "mam/meta_words/runner.h"
 #include "wordify_types.h"
 
 namespace mam::whisper_cpp {
@@ -11,5 +12,10 @@ using PathType = StringType;
 auto get_worker_executable_path() -> PathType;
 auto get_ggml_file_path() -> PathType;
 
+/** ISO 639-1 code of the transcription language, "auto" lets whisper detect
+ *  it */
+auto get_language() -> StringType;
+auto create_command(const PathType& file_path) -> const meta_words::Command;
+
 //------------------------------------------------------------------------
 } // namespace mam::whisper_cpp
\ No newline at end of file
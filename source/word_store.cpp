@@ -0,0 +1,264 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#include "word_store.h"
+#include "text_normalizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace mam::meta_words {
+namespace {
+
+//------------------------------------------------------------------------
+using Word                                      = std::string_view;
+using PunctuationMarks                          = std::array<Word, 15>;
+static const PunctuationMarks PUNCTUATION_MARKS = {".", "?", "!", ",",  ";",
+                                                   "-", "(", ")", "[",  "]",
+                                                   "{", "}", "'", "\"", "..."};
+auto is_puntuation_mark(const Word& word) -> bool
+{
+    for (auto& el : PUNCTUATION_MARKS)
+    {
+        if (el == word)
+            return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------
+auto is_in_range(WordStore::Millis begin,
+                 WordStore::Millis duration,
+                 WordStore::Millis start,
+                 WordStore::Millis end) -> bool
+{
+    const auto word_end = begin + duration;
+
+    return (begin >= start && begin < end) ||
+           (word_end >= start && word_end < end);
+}
+
+//------------------------------------------------------------------------
+auto to_string_view(const StringType& arena,
+                    const std::vector<uint32_t>& offsets,
+                    WordStore::TermId term) -> std::string_view
+{
+    const auto begin = offsets[term];
+    const auto end   = offsets[term + 1];
+    return std::string_view(arena).substr(begin, end - begin);
+}
+
+//------------------------------------------------------------------------
+template <typename T>
+auto capacity_bytes(const std::vector<T>& vec) -> size_t
+{
+    return vec.capacity() * sizeof(T);
+}
+
+//------------------------------------------------------------------------
+} // namespace
+
+//------------------------------------------------------------------------
+// WordStore
+//------------------------------------------------------------------------
+auto WordStore::create(const MetaWords& words) -> WordStorePtr
+{
+    Builder builder;
+    builder.reserve(words.size());
+    for (const auto& word : words)
+    {
+        builder.push_back(word.value, to_millis(word.begin),
+                          to_millis(word.duration));
+    }
+
+    return builder.build();
+}
+
+//------------------------------------------------------------------------
+auto WordStore::to_millis(Seconds seconds) -> Millis
+{
+    return static_cast<Millis>(std::lround(std::max(0., seconds) * 1000.));
+}
+
+//------------------------------------------------------------------------
+auto WordStore::to_seconds(Millis millis) -> Seconds
+{
+    return static_cast<Seconds>(millis) * 0.001;
+}
+
+//------------------------------------------------------------------------
+auto WordStore::begin(Index index) const -> Seconds
+{
+    return to_seconds(begins[index]);
+}
+
+//------------------------------------------------------------------------
+auto WordStore::duration(Index index) const -> Seconds
+{
+    return to_seconds(durations[index]);
+}
+
+//------------------------------------------------------------------------
+auto WordStore::text(Index index) const -> StringView
+{
+    return term_text(terms[index]);
+}
+
+//------------------------------------------------------------------------
+auto WordStore::normalized(Index index) const -> StringView
+{
+    return term_normalized(terms[index]);
+}
+
+//------------------------------------------------------------------------
+auto WordStore::count_terms() const -> size_t
+{
+    return text_offsets.size() - 1;
+}
+
+//------------------------------------------------------------------------
+auto WordStore::term_text(TermId term) const -> StringView
+{
+    return to_string_view(text_arena, text_offsets, term);
+}
+
+//------------------------------------------------------------------------
+auto WordStore::term_normalized(TermId term) const -> StringView
+{
+    return to_string_view(normalized_arena, normalized_offsets, term);
+}
+
+//------------------------------------------------------------------------
+auto WordStore::find_window(Seconds start, Seconds end) const -> WordWindow
+{
+    const auto start_ms = to_millis(start);
+    const auto end_ms   = to_millis(end);
+
+    // Words starting before 'start' can still end inside the range, but never
+    // earlier than 'max_duration' before it.
+    const auto lower = start_ms > max_duration ? start_ms - max_duration : 0;
+    auto first = std::lower_bound(begins.begin(), begins.end(), lower);
+    auto last  = std::lower_bound(first, begins.end(), end_ms);
+
+    auto first_index = static_cast<Index>(std::distance(begins.begin(), first));
+    const auto last_index =
+        static_cast<Index>(std::distance(begins.begin(), last));
+
+    while (first_index < last_index &&
+           !is_in_range(begins[first_index], durations[first_index], start_ms,
+                        end_ms))
+    {
+        ++first_index;
+    }
+
+    return {first_index, last_index};
+}
+
+//------------------------------------------------------------------------
+auto WordStore::to_meta_words() const -> MetaWords
+{
+    MetaWords words;
+    words.reserve(size());
+    for (Index i = 0; i < size(); i++)
+    {
+        MetaWord word;
+        word.value    = StringType(text(i));
+        word.begin    = begin(i);
+        word.duration = duration(i);
+        words.push_back(word);
+    }
+
+    return words;
+}
+
+//------------------------------------------------------------------------
+auto WordStore::memory_usage() const -> size_t
+{
+    return sizeof(WordStore) + capacity_bytes(begins) +
+           capacity_bytes(durations) + capacity_bytes(flags) +
+           capacity_bytes(terms) + text_arena.capacity() +
+           capacity_bytes(text_offsets) + normalized_arena.capacity() +
+           capacity_bytes(normalized_offsets);
+}
+
+//------------------------------------------------------------------------
+// WordStore::Builder
+//------------------------------------------------------------------------
+auto WordStore::Builder::reserve(size_t count) -> Builder&
+{
+    store.begins.reserve(count);
+    store.durations.reserve(count);
+    store.flags.reserve(count);
+    store.terms.reserve(count);
+
+    return *this;
+}
+
+//------------------------------------------------------------------------
+auto WordStore::Builder::push_back(StringView text,
+                                   Millis begin,
+                                   Millis duration) -> Builder&
+{
+    store.begins.push_back(begin);
+    store.durations.push_back(duration);
+    store.flags.push_back(is_puntuation_mark(text) ? PUNCTUATION_MARK : 0);
+    store.terms.push_back(intern(text));
+    store.max_duration = std::max(store.max_duration, duration);
+
+    return *this;
+}
+
+//------------------------------------------------------------------------
+auto WordStore::Builder::intern(StringView text) -> TermId
+{
+    const auto [iter, inserted] = term_ids.emplace(
+        StringType(text), static_cast<TermId>(term_ids.size()));
+    if (!inserted)
+        return iter->second;
+
+    store.text_arena.append(text);
+    store.text_offsets.push_back(
+        static_cast<uint32_t>(store.text_arena.size()));
+
+    store.normalized_arena.append(text_normalizer::normalize(text));
+    store.normalized_offsets.push_back(
+        static_cast<uint32_t>(store.normalized_arena.size()));
+
+    return iter->second;
+}
+
+//------------------------------------------------------------------------
+auto WordStore::Builder::build() -> WordStorePtr
+{
+    // Whisper delivers the words in order, sorting is only needed if the
+    // words have been pushed in any other order.
+    if (!std::is_sorted(store.begins.begin(), store.begins.end()))
+    {
+        std::vector<Index> order(store.size());
+        std::iota(order.begin(), order.end(), Index(0));
+        std::stable_sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+            return store.begins[lhs] < store.begins[rhs];
+        });
+
+        auto reorder = [&order](auto& column) {
+            auto sorted = column;
+            for (size_t i = 0; i < order.size(); i++)
+                sorted[i] = column[order[i]];
+            column = std::move(sorted);
+        };
+
+        reorder(store.begins);
+        reorder(store.durations);
+        reorder(store.flags);
+        reorder(store.terms);
+    }
+
+    store.text_arena.shrink_to_fit();
+    store.normalized_arena.shrink_to_fit();
+    term_ids.clear();
+
+    return WordStorePtr(new WordStore(std::move(store)));
+}
+
+//------------------------------------------------------------------------
+} // namespace mam::meta_words
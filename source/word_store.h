@@ -0,0 +1,148 @@
+// Copyright (c) 2023-present, WordifyOrg.
+
+#pragma once
+
+#include "mam/meta_words/meta_word.h"
+#include "wordify_types.h"
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mam::meta_words {
+
+//------------------------------------------------------------------------
+// WordWindow
+//
+// Half open index range [first, last) into a WordStore.
+//------------------------------------------------------------------------
+struct WordWindow
+{
+    Index first = 0;
+    Index last  = 0;
+
+    auto size() const -> Index { return last - first; }
+    auto empty() const -> bool { return first == last; }
+    auto contains(Index index) const -> bool
+    {
+        return first <= index && index < last;
+    }
+};
+
+//------------------------------------------------------------------------
+// WordStore
+//
+// Immutable list of all words of an audio source, sorted by their begin time.
+// One instance is shared by the audio source, its audio modifications and
+// all of their playback regions. Playback regions only keep a WordWindow
+// into it.
+//
+// Words are stored column wise (structure of arrays): 32 bit millisecond
+// begin and duration, a flags byte and a term id. Term ids point into a
+// table of interned words, whose UTF-8 text and normalized text (see
+// text_normalizer) live in two contiguous string arenas. Words are
+// normalized once per distinct word when the store is built.
+//------------------------------------------------------------------------
+class WordStore
+{
+public:
+    //--------------------------------------------------------------------
+    using Seconds      = double;
+    using Millis       = uint32_t;
+    using TermId       = uint32_t;
+    using Flags        = uint8_t;
+    using StringView   = std::string_view;
+    using WordStorePtr = std::shared_ptr<const WordStore>;
+
+    enum Flag : Flags
+    {
+        PUNCTUATION_MARK = 1 << 0,
+    };
+
+    class Builder;
+
+    static auto create(const MetaWords& words) -> WordStorePtr;
+    static auto to_millis(Seconds seconds) -> Millis;
+    static auto to_seconds(Millis millis) -> Seconds;
+
+    auto size() const -> Index { return begins.size(); }
+    auto empty() const -> bool { return begins.empty(); }
+
+    auto begin_ms(Index index) const -> Millis { return begins[index]; }
+    auto duration_ms(Index index) const -> Millis { return durations[index]; }
+    auto begin(Index index) const -> Seconds;
+    auto duration(Index index) const -> Seconds;
+    auto term(Index index) const -> TermId { return terms[index]; }
+    auto text(Index index) const -> StringView;
+    auto normalized(Index index) const -> StringView;
+    auto is_punctuation_mark(Index index) const -> bool
+    {
+        return (flags[index] & PUNCTUATION_MARK) != 0;
+    }
+
+    auto count_terms() const -> size_t;
+    auto term_text(TermId term) const -> StringView;
+    auto term_normalized(TermId term) const -> StringView;
+
+    /** Returns the window of all words which begin or end inside
+     *  [start, end). Runs in O(log n).
+     */
+    auto find_window(Seconds start, Seconds end) const -> WordWindow;
+    auto to_meta_words() const -> MetaWords;
+    auto memory_usage() const -> size_t;
+
+    //--------------------------------------------------------------------
+private:
+    using MillisColumn = std::vector<Millis>;
+    using TermColumn   = std::vector<TermId>;
+    using FlagsColumn  = std::vector<Flags>;
+    using Offsets      = std::vector<uint32_t>;
+
+    WordStore() = default;
+
+    // Word columns
+    MillisColumn begins;
+    MillisColumn durations;
+    FlagsColumn flags;
+    TermColumn terms;
+
+    // Interned string table, term i is [offsets[i], offsets[i + 1])
+    StringType text_arena;
+    Offsets text_offsets{0};
+    StringType normalized_arena;
+    Offsets normalized_offsets{0};
+
+    Millis max_duration = 0;
+};
+
+//------------------------------------------------------------------------
+// WordStore::Builder
+//
+// Collects words in any order, interns their text and creates the immutable
+// WordStore sorted by begin time.
+//------------------------------------------------------------------------
+class WordStore::Builder
+{
+public:
+    //--------------------------------------------------------------------
+    auto reserve(size_t count) -> Builder&;
+    auto push_back(StringView text, Millis begin, Millis duration)
+        -> Builder&;
+    auto build() -> WordStorePtr;
+
+    //--------------------------------------------------------------------
+private:
+    using TermIds = std::unordered_map<StringType, TermId>;
+
+    auto intern(StringView text) -> TermId;
+
+    WordStore store;
+    TermIds term_ids;
+};
+
+//------------------------------------------------------------------------
+using WordStorePtr = WordStore::WordStorePtr;
+
+//------------------------------------------------------------------------
+} // namespace mam::meta_words
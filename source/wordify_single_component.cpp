@@ -1,12 +1,13 @@
 // Copyright (c) 2023-present, WordifyOrg.
 
 #include "wordify_single_component.h"
+#include "controllers/frequency_controller.h"
 #include "controllers/list_controller.h"
+#include "controllers/live_transcript_controller.h"
 #include "controllers/preferences_controller.h"
 #include "controllers/search_controller.h"
 #include "controllers/spinner_controller.h"
 #include "controllers/waveform_controller.h"
-#include "meta_words_editor_renderer.h"
 #include "meta_words_editor_view.h"
 #include "meta_words_playback_renderer.h"
 #include "parameter_ids.h"
@@ -56,17 +57,33 @@ static auto on_playback_renderer(meta_words::PlaybackRenderer& playbackRenderer,
 }
 
 //------------------------------------------------------------------------
-static auto on_editor_renderer(meta_words::EditorRenderer& editorRenderer,
+static auto on_process_context(Playhead& playhead,
+                               Playhead::Writer writer,
                                Vst::ProcessData& data) -> void
 {
-    if (data.processContext)
+    // Hosts often bind one instance with all roles, so the playhead is
+    // published whatever renderer role is active
+    if (data.processContext && data.processContext->sampleRate > 0.)
     {
         const auto time = data.processContext->projectTimeSamples /
                           data.processContext->sampleRate;
-        editorRenderer.update_project_time(time);
+        const auto is_playing =
+            (data.processContext->state & Vst::ProcessContext::kPlaying) != 0;
+        playhead.publish(writer, time, is_playing);
     }
 }
 
+//------------------------------------------------------------------------
+static auto on_live_input(LiveTranscriber& live_transcriber,
+                          Vst::ProcessData& data) -> void
+{
+    if (data.numInputs == 0 || data.inputs[0].numChannels == 0)
+        return;
+
+    live_transcriber.push(data.inputs[0].channelBuffers32[0],
+                          static_cast<size_t>(data.numSamples));
+}
+
 //------------------------------------------------------------------------
 static auto on_editor_view(meta_words::EditorView& /*editorView*/,
                            Vst::ProcessData& /*data*/) -> void
@@ -75,12 +92,14 @@ static auto on_editor_view(meta_words::EditorView& /*editorView*/,
 
 //------------------------------------------------------------------------
 using Range = std::pair<size_t, size_t>;
-static auto to_sample_range(const meta_words::MetaWord& word,
+static auto to_sample_range(const RegionWords& words,
+                            Index word_index,
                             double sample_rate) -> const Range
 {
-    const auto begin_sample = static_cast<size_t>(word.begin * sample_rate);
+    const auto begin_sample =
+        static_cast<size_t>(words.begin(word_index) * sample_rate);
     const auto duration_sample =
-        static_cast<size_t>(word.duration * sample_rate);
+        static_cast<size_t>(words.duration(word_index) * sample_rate);
     return {begin_sample, duration_sample};
 }
 
@@ -104,14 +123,14 @@ static auto build_waveform_data(ARADocumentController* controller)
 
     const auto sample_rate = audioSrc->getSampleRate();
 
-    const auto span_data   = region->get_audio_buffer();
-    const auto region_data = region->get_region_data().words;
-    size_t a               = 0;
-    size_t b               = 0;
-    if ((selection.word_index < region_data.size()))
+    const auto span_data    = region->get_audio_buffer();
+    const auto region_words = region->get_region_words();
+    size_t a                = 0;
+    size_t b                = 0;
+    if (region_words.contains(selection.word_index))
     {
-        const auto word_sample_range = to_sample_range(
-            region_data.at(selection.word_index).word, sample_rate);
+        const auto word_sample_range =
+            to_sample_range(region_words, selection.word_index, sample_rate);
 
         // Wow, wild calculations here. But it seems to work for now :)
         const auto span_begin_samples = span_data.offset_samples;
@@ -234,6 +253,7 @@ tresult PLUGIN_API WordifySingleComponent::terminate()
     // some memory!
 
     store_parameters();
+    live_transcriber.stop();
     task_managing::get_task_count_callback()->remove(task_count_handle);
 
     for (auto i = 0; i < parameters.getParameterCount(); i++)
@@ -264,12 +284,32 @@ tresult PLUGIN_API WordifySingleComponent::setActive(TBool state)
             playbackRenderer->disableRendering();
     }
 
+    if (state && is_live_mode())
+        live_transcriber.start(processSetup.sampleRate);
+    else
+        live_transcriber.stop();
+
+    // Another active instance takes over publishing the playhead
+    auto* document_controller =
+        araPlugInExtension.getDocumentController<ARADocumentController>();
+    if (!state && document_controller)
+        document_controller->get_playhead().release(this);
+
     return SingleComponentEffect::setActive(state);
 }
 
 //------------------------------------------------------------------------
 tresult PLUGIN_API WordifySingleComponent::process(Vst::ProcessData& data)
 {
+    if (live_transcriber.is_running())
+        on_live_input(live_transcriber, data);
+
+    if (auto* document_controller =
+            araPlugInExtension.getDocumentController<ARADocumentController>())
+    {
+        on_process_context(document_controller->get_playhead(), this, data);
+    }
+
     if (data.numOutputs == 0)
         return kResultOk;
 
@@ -284,12 +324,6 @@ tresult PLUGIN_API WordifySingleComponent::process(Vst::ProcessData& data)
     {
         on_playback_renderer(*playbackRenderer, data);
     }
-    else if (auto editorRenderer =
-                 araPlugInExtension
-                     .getEditorRenderer<meta_words::EditorRenderer>())
-    {
-        on_editor_renderer(*editorRenderer, data);
-    }
     else if (auto editorView =
                  araPlugInExtension.getEditorView<meta_words::EditorView>())
     {
@@ -297,12 +331,18 @@ tresult PLUGIN_API WordifySingleComponent::process(Vst::ProcessData& data)
     }
     else
     {
-        // No support for non ARA
+        // Without ARA the input is transcribed live, see on_live_input
     }
 
     return kResultOk;
 }
 
+//------------------------------------------------------------------------
+auto WordifySingleComponent::is_live_mode() -> bool
+{
+    return araPlugInExtension.getDocumentController() == nullptr;
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API
 WordifySingleComponent::setupProcessing(Vst::ProcessSetup& newSetup)
@@ -348,7 +388,12 @@ VSTGUI::IController* WordifySingleComponent::createSubController(
     // auto* editorView = araPlugInExtension.getEditorView();
 
     if (!document_controller)
+    {
+        if (VSTGUI::UTF8StringView(name) == "MetaWordsListController")
+            return new LiveTranscriptController(&live_transcriber, description);
+
         return nullptr;
+    }
 
     if (VSTGUI::UTF8StringView(name) == "MetaWordsListController")
     {
@@ -370,7 +415,12 @@ VSTGUI::IController* WordifySingleComponent::createSubController(
     {
         return new SearchController(
             document_controller,
-            getParameterObject(ParamIds::kParamIdSmartSearchMode));
+            getParameterObject(ParamIds::kParamIdSmartSearchMode),
+            getParameterObject(ParamIds::kParamIdSmartSearchMethod));
+    }
+    else if (VSTGUI::UTF8StringView(name) == "FrequencyController")
+    {
+        return new FrequencyController(document_controller);
     }
     else if (VSTGUI::UTF8StringView(name) == "SpinnerController")
     {
@@ -515,6 +565,17 @@ auto WordifySingleComponent::restore_parameters() -> void
         parameters.addParameter(p);
         p->addDependent(this);
     }
+    if (auto* p = new Vst::StringListParameter(
+            STR("SmartSearchMethod"), ParamIds::kParamIdSmartSearchMethod))
+    {
+        // Same order as meta_words::serde::SmartSearchMethod
+        p->appendString(STR("Fuzzy"));
+        p->appendString(STR("Sounds Like"));
+        p->appendString(STR("Stemmed"));
+        p->setNormalized(p->toNormalized(prefs.smart_search_method));
+        parameters.addParameter(p);
+        p->addDependent(this);
+    }
     if (auto* p = new Vst::Parameter(STR("SmartSearchNext"),
                                      ParamIds::kParamIdSmartSearchNext))
     {
@@ -566,6 +627,15 @@ auto WordifySingleComponent::store_parameters() -> void
                                  : meta_words::serde::SmartSearch::Off;
     }
 
+    if (auto* smart_search_method_param =
+            getParameterObject(ParamIds::kParamIdSmartSearchMethod))
+    {
+        const auto index = smart_search_method_param->toPlain(
+            smart_search_method_param->getNormalized());
+        prefs.smart_search_method =
+            static_cast<meta_words::serde::SmartSearchMethod>(index);
+    }
+
     meta_words::serde::write_to(prefs, COMPANY_NAME_STR, PLUGIN_NAME_STR);
 }
 
@@ -586,6 +656,7 @@ void PLUGIN_API WordifySingleComponent::update(FUnknown* changedUnknown,
                 break;
             }
             case ParamIds::kParamIdSmartSearchMode:
+            case ParamIds::kParamIdSmartSearchMethod:
                 // Nothing here
                 break;
             case ParamIds::kParamIdSmartSearchNext:
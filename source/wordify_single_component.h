@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "live_transcriber.h"
 #include "warn_cpp/suppress_warnings.h"
 #include "task_manager.h"
 BEGIN_SUPPRESS_WARNINGS
@@ -115,8 +116,10 @@ protected:
 
     auto restore_parameters() -> void;
     auto store_parameters() -> void;
+    auto is_live_mode() -> bool;
 
     bool dark_scheme = false;
+    LiveTranscriber live_transcriber;
     task_managing::TaskCountCallback::Handle task_count_handle;
 };
 
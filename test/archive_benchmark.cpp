@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------
+// Copyright (c) 2023-present, WordifyOrg.
+//------------------------------------------------------------------------
+
+// Save and load time and size of the JSON archive (version 1) against the
+// binary archive (version 2), with raw and with compressed blocks, for a
+// generated project of 1M words spread over 60 audio sources. Also checks
+// that all of them round trip and that loading the compressed archive is
+// faster than parsing the JSON one.
+//
+// g++ -O2 -std=c++17 -I ../source -I <meta-words>/include -I <json>/include
+//     archive_benchmark.cpp ../source/meta_words_serde.cpp
+//     ../source/lz_codec.cpp
+
+#include "meta_words_serde.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace mam::meta_words;
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------
+static auto elapsed_ms(Clock::time_point start) -> double
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+//------------------------------------------------------------------------
+static auto generate_archive(size_t num_sources, size_t words_per_source)
+    -> serde::Archive
+{
+    // Zipf like vocabulary, a few words are very frequent
+    constexpr size_t VOCABULARY_SIZE = 5000;
+    std::vector<mam::StringType> vocabulary;
+    for (size_t i = 0; i < VOCABULARY_SIZE; i++)
+        vocabulary.push_back("word" + std::to_string(i));
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    std::uniform_real_distribution<double> gap(0.01, 0.4);
+
+    serde::Archive archive;
+    for (size_t s = 0; s < num_sources; s++)
+    {
+        serde::AudioSource audio_source;
+        audio_source.persistent_id = "audio-source-" + std::to_string(s);
+
+        double begin = 0.;
+        for (size_t w = 0; w < words_per_source; w++)
+        {
+            const auto rank = static_cast<size_t>(
+                std::pow(static_cast<double>(VOCABULARY_SIZE), uniform(rng)));
+            const auto duration = std::round(gap(rng) * 100.) / 100.;
+            audio_source.words.push_back(
+                {vocabulary[rank - 1], begin, duration});
+            begin += std::round((duration + gap(rng)) * 100.) / 100.;
+        }
+
+        archive.audio_sources.push_back(std::move(audio_source));
+    }
+
+    return archive;
+}
+
+//------------------------------------------------------------------------
+static auto is_equal(const serde::Archive& lhs, const serde::Archive& rhs)
+    -> bool
+{
+    constexpr double TOLERANCE = 1e-6;
+
+    if (lhs.audio_sources.size() != rhs.audio_sources.size())
+        return false;
+
+    for (size_t s = 0; s < lhs.audio_sources.size(); s++)
+    {
+        const auto& words0 = lhs.audio_sources[s].words;
+        const auto& words1 = rhs.audio_sources[s].words;
+        if (lhs.audio_sources[s].persistent_id !=
+                rhs.audio_sources[s].persistent_id ||
+            words0.size() != words1.size())
+            return false;
+
+        for (size_t w = 0; w < words0.size(); w++)
+        {
+            if (words0[w].value != words1[w].value ||
+                std::abs(words0[w].begin - words1[w].begin) > TOLERANCE ||
+                std::abs(words0[w].duration - words1[w].duration) > TOLERANCE)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------
+struct Result
+{
+    bool ok        = false;
+    double load_ms = 0.;
+};
+
+//------------------------------------------------------------------------
+static auto run(serde::Archive archive, size_t version, bool compress_blocks)
+    -> Result
+{
+    archive.version         = version;
+    archive.compress_blocks = compress_blocks;
+
+    mam::StringType serialized;
+    auto start = Clock::now();
+    serde::serialize(archive, serialized);
+    const auto save_ms = elapsed_ms(start);
+
+    serde::Archive restored;
+    start              = Clock::now();
+    const bool read    = serde::deserialize(serialized, restored);
+    const auto load_ms = elapsed_ms(start);
+
+    size_t num_words = 0;
+    for (const auto& audio_source : archive.audio_sources)
+        num_words += audio_source.words.size();
+
+    const bool ok = read && restored.version == version &&
+                    is_equal(archive, restored);
+    std::cout << "version " << version
+              << (compress_blocks && version == serde::BINARY_ARCHIVE_VERSION
+                      ? " compressed"
+                      : "")
+              << ": " << serialized.size() / 1024 << " KiB, save " << save_ms
+              << " ms, load " << load_ms << " ms ("
+              << num_words / load_ms / 1000. << "M words/s)"
+              << (ok ? "" : ", ROUND TRIP FAILED") << "\n";
+
+    return {ok, load_ms};
+}
+
+//------------------------------------------------------------------------
+int main()
+{
+    constexpr size_t NUM_SOURCES      = 60;
+    constexpr size_t WORDS_PER_SOURCE = 1000000 / NUM_SOURCES;
+
+    const auto archive = generate_archive(NUM_SOURCES, WORDS_PER_SOURCE);
+
+    const auto json = run(archive, serde::JSON_ARCHIVE_VERSION, false);
+    const auto raw  = run(archive, serde::BINARY_ARCHIVE_VERSION, false);
+    const auto compressed =
+        run(archive, serde::BINARY_ARCHIVE_VERSION, true);
+
+    bool ok = json.ok && raw.ok && compressed.ok &&
+              compressed.load_ms < json.load_ms;
+
+    // Truncated archives must be rejected, not crash
+    mam::StringType serialized;
+    serde::serialize(archive, serialized);
+    serialized.resize(serialized.size() / 2);
+    serde::Archive truncated;
+    ok = !serde::deserialize(serialized, truncated) && ok;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------
+// Copyright (c) 2023-present, WordifyOrg.
+//------------------------------------------------------------------------
+
+// Round trip test of the lz_codec for empty, short, repetitive, random and
+// text like inputs, with lengths crossing the nibble and byte borders and
+// matches further back than the 16 bit offset. Truncated streams and wrong
+// sizes must be rejected, corrupt streams must not write or read out of
+// bounds. Build it with -fsanitize=address to catch them.
+//
+// g++ -O2 -std=c++17 -I ../source lz_codec_test.cpp ../source/lz_codec.cpp
+
+#include "lz_codec.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mam;
+
+//------------------------------------------------------------------------
+static auto random_bytes(std::mt19937& rng, size_t size, size_t alphabet)
+    -> std::string
+{
+    std::string bytes(size, '\0');
+    for (auto& c : bytes)
+        c = static_cast<char>(rng() % alphabet);
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------
+static auto make_inputs(std::mt19937& rng) -> std::vector<std::string>
+{
+    std::vector<std::string> inputs = {"", "a", "abc", "abcd", "abcabcabc"};
+
+    // Runs crossing the borders of the literal and match lengths
+    for (const size_t size : {4, 5, 18, 19, 20, 270, 271, 272, 600, 100000})
+        inputs.push_back(std::string(size, 'x'));
+
+    for (const size_t size : {14, 15, 16, 269, 270, 271, 1000, 70000})
+        inputs.push_back(random_bytes(rng, size, 256));
+
+    // Words repeating like in a transcript
+    std::string text;
+    while (text.size() < 200000)
+        text += "word" + std::to_string(rng() % 500) + " ";
+    inputs.push_back(text);
+
+    // The same bytes again beyond the maximum offset
+    const auto block = random_bytes(rng, 1000, 256);
+    inputs.push_back(block + random_bytes(rng, 70000, 4) + block);
+
+    return inputs;
+}
+
+//------------------------------------------------------------------------
+int main()
+{
+    constexpr size_t NUM_CORRUPTIONS = 200;
+
+    std::mt19937 rng(42);
+    size_t failures  = 0;
+    const auto fail = [&](size_t size, const char* message) {
+        std::cout << size << " bytes: " << message << "\n";
+        ++failures;
+    };
+
+    const auto inputs = make_inputs(rng);
+    for (const auto& input : inputs)
+    {
+        StringType compressed;
+        lz_codec::compress(input, compressed);
+
+        // Decompressed bytes are appended
+        StringType out = "head";
+        if (!lz_codec::decompress(compressed, input.size(), out) ||
+            out != "head" + input)
+            fail(input.size(), "round trip failed");
+
+        if (lz_codec::decompress(compressed, input.size() + 1, out) ||
+            (!input.empty() &&
+             lz_codec::decompress(compressed, input.size() - 1, out)))
+            fail(input.size(), "wrong size was decompressed");
+
+        // Short streams are truncated at every byte, long ones at a few
+        const size_t step = compressed.size() < 1000 ? 1 : 97;
+        for (size_t size = 0; size < compressed.size(); size += step)
+        {
+            if (lz_codec::decompress(compressed.substr(0, size), input.size(),
+                                     out))
+                fail(input.size(), "truncated stream was decompressed");
+        }
+
+        // Anything goes as long as nothing is written or read out of bounds
+        for (size_t i = 0; i < NUM_CORRUPTIONS && !compressed.empty(); i++)
+        {
+            auto corrupt = compressed;
+            corrupt[rng() % corrupt.size()] = static_cast<char>(rng());
+            out.clear();
+            lz_codec::decompress(corrupt, input.size(), out);
+        }
+    }
+
+    std::cout << (failures == 0 ? "OK" : "FAILED") << ", " << inputs.size()
+              << " inputs, " << failures << " failures\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------
+// Copyright (c) 2023-present, WordifyOrg.
+//------------------------------------------------------------------------
+
+// Round trip test of the JSON archive (version 1) and the binary archive
+// (version 2) with raw and with compressed blocks for small projects,
+// including empty ones and UTF-8 words. Every truncation of an archive and
+// a few corrupt headers and indexes must be rejected, randomly corrupted
+// archives must not crash. Build it with -fsanitize=address to catch reads
+// out of bounds.
+//
+// g++ -O2 -std=c++17 -I ../source -I <meta-words>/include -I <json>/include
+//     meta_words_serde_test.cpp ../source/meta_words_serde.cpp
+//     ../source/lz_codec.cpp
+
+#include "meta_words_serde.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace mam::meta_words;
+
+//------------------------------------------------------------------------
+struct Format
+{
+    size_t version;
+    bool compress_blocks;
+    const char* name;
+};
+
+//------------------------------------------------------------------------
+static auto make_archive(std::mt19937& rng, size_t num_sources)
+    -> serde::Archive
+{
+    const std::vector<mam::StringType> vocabulary = {
+        "hello", "world", "thank", "you", "so", "much", "café", "naïve", "",
+        "12", "Don't"};
+
+    serde::Archive archive;
+    for (size_t s = 0; s < num_sources; s++)
+    {
+        serde::AudioSource audio_source;
+        audio_source.persistent_id = "source-" + std::to_string(s);
+
+        // Every third one is empty
+        const size_t num_words = s % 3 == 2 ? 0 : rng() % 40;
+        double begin           = 0.;
+        for (size_t w = 0; w < num_words; w++)
+        {
+            const auto duration = static_cast<double>(rng() % 1000) / 1000.;
+            audio_source.words.push_back(
+                {vocabulary[rng() % vocabulary.size()], begin, duration});
+            begin += duration + static_cast<double>(rng() % 500) / 1000.;
+        }
+
+        archive.audio_sources.push_back(std::move(audio_source));
+    }
+
+    return archive;
+}
+
+//------------------------------------------------------------------------
+static auto is_equal(const serde::Archive& lhs, const serde::Archive& rhs)
+    -> bool
+{
+    constexpr double TOLERANCE = 1e-6;
+
+    if (lhs.audio_sources.size() != rhs.audio_sources.size())
+        return false;
+
+    for (size_t s = 0; s < lhs.audio_sources.size(); s++)
+    {
+        const auto& words0 = lhs.audio_sources[s].words;
+        const auto& words1 = rhs.audio_sources[s].words;
+        if (lhs.audio_sources[s].persistent_id !=
+                rhs.audio_sources[s].persistent_id ||
+            words0.size() != words1.size())
+            return false;
+
+        for (size_t w = 0; w < words0.size(); w++)
+        {
+            if (words0[w].value != words1[w].value ||
+                std::abs(words0[w].begin - words1[w].begin) > TOLERANCE ||
+                std::abs(words0[w].duration - words1[w].duration) > TOLERANCE)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------
+static auto serialize(serde::Archive archive, const Format& format)
+    -> mam::StringType
+{
+    archive.version         = format.version;
+    archive.compress_blocks = format.compress_blocks;
+
+    mam::StringType serialized;
+    serde::serialize(archive, serialized);
+    return serialized;
+}
+
+//------------------------------------------------------------------------
+static auto is_rejected(const mam::StringType& serialized) -> bool
+{
+    serde::Archive archive;
+    return !serde::deserialize(serialized, archive);
+}
+
+//------------------------------------------------------------------------
+int main()
+{
+    constexpr size_t NUM_ARCHIVES    = 10;
+    constexpr size_t NUM_CORRUPTIONS = 200;
+
+    const std::vector<Format> formats = {
+        {serde::JSON_ARCHIVE_VERSION, false, "version 1"},
+        {serde::BINARY_ARCHIVE_VERSION, false, "version 2"},
+        {serde::BINARY_ARCHIVE_VERSION, true, "version 2 compressed"},
+    };
+
+    std::mt19937 rng(42);
+    size_t failures = 0;
+    const auto fail = [&](const Format& format, const char* message) {
+        std::cout << format.name << ": " << message << "\n";
+        ++failures;
+    };
+
+    for (size_t n = 0; n < NUM_ARCHIVES; n++)
+    {
+        const auto archive = make_archive(rng, n % 5);
+        for (const auto& format : formats)
+        {
+            const auto serialized = serialize(archive, format);
+
+            serde::Archive restored;
+            if (!serde::deserialize(serialized, restored) ||
+                restored.version != format.version ||
+                !is_equal(archive, restored))
+                fail(format, "round trip failed");
+
+            for (size_t size = 0; size < serialized.size(); size++)
+            {
+                if (!is_rejected(serialized.substr(0, size)))
+                    fail(format, "truncated archive was read");
+            }
+
+            // Anything goes as long as nothing is read out of bounds
+            for (size_t i = 0; i < NUM_CORRUPTIONS && !serialized.empty(); i++)
+            {
+                auto corrupt = serialized;
+                corrupt[rng() % corrupt.size()] = static_cast<char>(rng());
+                is_rejected(corrupt);
+            }
+        }
+    }
+
+    // Corrupt header and index of a binary archive, see meta_words_serde.cpp
+    constexpr size_t VERSION_POSITION = 4;
+    constexpr size_t FLAGS_POSITION   = 8;
+    constexpr size_t COUNT_POSITION   = 18; // After the id "a"
+
+    serde::Archive single;
+    single.audio_sources.push_back({"a", {{"hello", 0., 1.}}});
+    for (const auto& format : formats)
+    {
+        if (format.version != serde::BINARY_ARCHIVE_VERSION)
+            continue;
+
+        const auto serialized = serialize(single, format);
+
+        auto corrupt              = serialized;
+        corrupt[VERSION_POSITION] = 3;
+        if (!is_rejected(corrupt))
+            fail(format, "unknown version was read");
+
+        corrupt                 = serialized;
+        corrupt[FLAGS_POSITION] = 1 << 7;
+        if (!is_rejected(corrupt))
+            fail(format, "unknown flags were read");
+
+        corrupt                 = serialized;
+        corrupt[COUNT_POSITION] = 0x7f;
+        if (!is_rejected(corrupt))
+            fail(format, "too many words were read");
+    }
+
+    std::cout << (failures == 0 ? "OK" : "FAILED") << ", " << NUM_ARCHIVES
+              << " archives, " << failures << " failures\n";
+
+    return failures == 0 ? 0 : 1;
+}
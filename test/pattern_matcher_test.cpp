@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------
+// Copyright (c) 2023-present, WordifyOrg.
+//------------------------------------------------------------------------
+
+// Test of the PatternMatcher DFA: wildcards, regular expressions matching
+// single words and several words, and patterns which must be rejected
+// because of syntax errors or the size limits.
+//
+// g++ -O2 -std=c++17 -I ../source pattern_matcher_test.cpp
+//     ../source/pattern_matcher.cpp ../source/text_normalizer.cpp
+
+#include "pattern_matcher.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mam;
+using OptLength = PatternMatcher::OptLength;
+
+//------------------------------------------------------------------------
+struct WordCase
+{
+    std::string query;
+    std::string text;
+    bool expected;
+};
+
+//------------------------------------------------------------------------
+struct SpanCase
+{
+    std::string query;
+    std::string words;
+    OptLength expected;
+};
+
+//------------------------------------------------------------------------
+static auto to_string(const OptLength& length) -> std::string
+{
+    return length ? std::to_string(*length) : "none";
+}
+
+//------------------------------------------------------------------------
+int main()
+{
+    // clang-format off
+    const std::vector<WordCase> word_cases = {
+        // Wildcards
+        {"gonna*",          "gonna",    true},
+        {"gonna*",          "gonnas",   true},
+        {"gonna*",          "gon",      false},
+        {"ca?e",            "cafe",     true},
+        {"caf?s",           "cafés",    true},
+        {"ca?e",            "cae",      false},
+        {"wh?t?",           "what",     true},
+        {"wh?t?",           "whats",    false},
+        {"*ing",            "singing",  true},
+        {"*ing",            "sing ing", false},
+        // Alternation and groups
+        {"/um|uh|erm/",     "um",       true},
+        {"/um|uh|erm/",     "erm",      true},
+        {"/um|uh|erm/",     "umm",      false},
+        {"/(re)?do/",       "redo",     true},
+        {"/(re)?do/",       "do",       true},
+        {"/(re)?do/",       "rere",     false},
+        {"/(a*)*b/",        "aaab",     true},
+        {"/(a*)*b/",        "aaa",      false},
+        // Optional, repetitions and classes
+        {"/colou?r/",       "color",    true},
+        {"/colou?r/",       "colour",   true},
+        {"/colou?r/",       "colouur",  false},
+        {"/\\d+/",          "2023",     true},
+        {"/\\d+/",          "20a",      false},
+        {"/\\d+/",          "",         false},
+        {"/\\d{2,4}/",      "20",       true},
+        {"/\\d{2,4}/",      "20234",    false},
+        {"/[A-C]x/",        "bx",       true},
+        {"/[^0-9]+/",       "abc",      true},
+        {"/[^0-9]+/",       "a1",       false},
+        {"/Hello/",         "hello",    true},
+        {"/h.llo/",         "hallo",    true},
+        {"/h.llo/",         "h llo",    true},
+        {"/h\\Sllo/",       "h llo",    false},
+    };
+
+    const std::vector<SpanCase> span_cases = {
+        {"/thank .* much/",        "thank you so much",   17},
+        {"/thank .* much/",        "thank you much more", 14},
+        {"/thank you( so)? much/", "thank you much",      14},
+        {"/thank you( so)? much/", "thank you so much",   17},
+        {"thank * much",           "thank you much more", 14},
+        {"thank * much",           "thank you so much",   std::nullopt},
+        {"/al.*/",                 "alpha beta gamma",    16},
+        {"/al\\S*/",               "alpha beta gamma",    5},
+        {"/you|you so/",           "you so much",         6},
+        {"/so much/",              "you so much",         std::nullopt},
+        {"/a b/",                  "a bc",                std::nullopt},
+    };
+
+    const std::vector<std::string> rejected = {
+        "/a{17}/",
+        "/a{2,17}/",
+        "/((((a{16}){16}){16}){16})/",
+        "/((a{16}){16}){16}/",
+        "/.{0,200}/",
+        "/(/",
+        "/(a/",
+        "/a)/",
+        "/*a/",
+        "/a|*/",
+        "/[a-/",
+        "/\\/",
+        "hello",
+        "what?",
+    };
+    // clang-format on
+
+    size_t failures = 0;
+    for (const auto& c : word_cases)
+    {
+        const auto matcher = PatternMatcher::create(c.query);
+        if (!matcher || matcher->is_match(c.text) != c.expected)
+        {
+            std::cout << "is_match(\"" << c.query << "\", \"" << c.text
+                      << "\") is wrong, expected " << c.expected << "\n";
+            ++failures;
+        }
+    }
+
+    for (const auto& c : span_cases)
+    {
+        const auto matcher = PatternMatcher::create(c.query);
+        const auto actual =
+            matcher ? matcher->longest_match(c.words) : std::nullopt;
+        if (!matcher || actual != c.expected)
+        {
+            std::cout << "longest_match(\"" << c.query << "\", \"" << c.words
+                      << "\") = " << to_string(actual) << ", expected "
+                      << to_string(c.expected) << "\n";
+            ++failures;
+        }
+    }
+
+    for (const auto& query : rejected)
+    {
+        if (PatternMatcher::create(query))
+        {
+            std::cout << "create(\"" << query << "\") must fail\n";
+            ++failures;
+        }
+    }
+
+    // Only patterns which can match a space span words
+    for (const auto& [query, spans] :
+         std::vector<std::pair<std::string, bool>>{{"/um|uh/", false},
+                                                   {"gonna*", false},
+                                                   {"/a\\S+/", false},
+                                                   {"/a.b/", true},
+                                                   {"/a\\sb/", true},
+                                                   {"thank * much", true}})
+    {
+        const auto matcher = PatternMatcher::create(query);
+        if (!matcher || matcher->spans_words() != spans)
+        {
+            std::cout << "spans_words(\"" << query << "\") is wrong\n";
+            ++failures;
+        }
+    }
+
+    const auto num_cases = word_cases.size() + span_cases.size() +
+                           rejected.size();
+    std::cout << (failures == 0 ? "OK" : "FAILED") << ", " << num_cases
+              << " cases, " << failures << " failures\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------
+// Copyright (c) 2023-present, WordifyOrg.
+//------------------------------------------------------------------------
+
+// Benchmark of scanning regions on a ThreadPool the way the SearchEngine
+// does, see for_each_in_order. 400 regions of 2500 words are scanned with
+// the intermediate fuzzy match, once on the calling thread and once per
+// pool size up to the number of cores. The speedup is only meaningful on a
+// machine with more than one core.
+//
+// g++ -O2 -std=c++17 -pthread -I ../source region_scan_benchmark.cpp
+//     ../source/thread_pool.cpp ../source/string_matcher.cpp
+//     ../source/double_metaphone.cpp ../source/stemmer.cpp
+
+#include "string_matcher.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mam;
+using Clock   = std::chrono::steady_clock;
+using Words   = std::vector<std::string>;
+using Regions = std::vector<Words>;
+
+//------------------------------------------------------------------------
+static auto elapsed_ms(Clock::time_point start) -> double
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+//------------------------------------------------------------------------
+static auto count_hits(const Words& words, const std::string& query)
+    -> size_t
+{
+    using MatchMethod = StringMatcher::MatchMethod;
+
+    return static_cast<size_t>(
+        std::count_if(words.begin(), words.end(), [&](const auto& word) {
+            return StringMatcher::isMatch(
+                word, query, MatchMethod::intermediateFuzzyMatch);
+        }));
+}
+
+//------------------------------------------------------------------------
+int main()
+{
+    constexpr size_t NUM_REGIONS      = 400;
+    constexpr size_t WORDS_PER_REGION = 2500;
+    constexpr size_t NUM_RUNS         = 5;
+
+    std::mt19937 rng(42);
+    const std::string query = "transcript";
+
+    Regions regions(NUM_REGIONS, Words(WORDS_PER_REGION));
+    for (auto& words : regions)
+    {
+        for (auto& word : words)
+        {
+            word.resize(1 + rng() % 10);
+            for (auto& c : word)
+                c = static_cast<char>('a' + rng() % 26);
+        }
+        words[rng() % WORDS_PER_REGION] = "transcripts";
+    }
+
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "cores: " << cores << "\n";
+
+    auto start  = Clock::now();
+    size_t hits = 0;
+    for (size_t run = 0; run < NUM_RUNS; ++run)
+    {
+        for (const auto& words : regions)
+            hits += count_hits(words, query);
+    }
+    const auto sequential_ms = elapsed_ms(start) / NUM_RUNS;
+    std::cout << "sequential : " << sequential_ms << " ms, "
+              << hits / NUM_RUNS << " hits\n";
+
+    for (size_t num_threads = 1; num_threads <= cores; num_threads *= 2)
+    {
+        ThreadPool pool(num_threads);
+
+        start = Clock::now();
+        hits  = 0;
+        for (size_t run = 0; run < NUM_RUNS; ++run)
+        {
+            for_each_in_order<size_t>(
+                pool, regions.size(),
+                [&](size_t i) { return count_hits(regions[i], query); },
+                [&](size_t /*i*/, size_t count) {
+                    hits += count;
+                    return true;
+                });
+        }
+
+        const auto pool_ms = elapsed_ms(start) / NUM_RUNS;
+        std::cout << num_threads << " thread(s): " << pool_ms << " ms, "
+                  << hits / NUM_RUNS << " hits, speedup "
+                  << sequential_ms / pool_ms << "\n";
+    }
+
+    return 0;
+}
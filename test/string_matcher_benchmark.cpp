@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------
+// Copyright (c) 2023-present, WordifyOrg.
+//------------------------------------------------------------------------
+
+// Microbenchmark of the fuzzy match kernels: the former DP matrix with one
+// heap allocation per row against the bit-parallel bounded distance, for
+// one query over 1M transcript like words.
+//
+// g++ -O2 -std=c++17 -I ../source string_matcher_benchmark.cpp
+//     ../source/string_matcher.cpp ../source/double_metaphone.cpp
+//     ../source/stemmer.cpp
+
+#include "string_matcher.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mam;
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------
+static auto elapsed_ms(Clock::time_point start) -> double
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+//------------------------------------------------------------------------
+// The former implementation of StringMatcher::isFuzzyMatch
+static auto matrix_is_match(const std::string& toMatch,
+                            const std::string& string,
+                            size_t max_distance) -> bool
+{
+    size_t x = toMatch.length();
+    size_t y = string.length();
+
+    std::vector<std::vector<int>> distanceVector(x + 1,
+                                                 std::vector<int>(y + 1, 0));
+
+    for (size_t i = 0; i <= x; ++i)
+        distanceVector[i][0] = static_cast<int>(i);
+    for (size_t j = 0; j <= y; ++j)
+        distanceVector[0][j] = static_cast<int>(j);
+
+    for (size_t i = 1; i <= x; ++i)
+    {
+        for (size_t j = 1; j <= y; ++j)
+        {
+            if (toMatch[i - 1] == string[j - 1])
+                distanceVector[i][j] = distanceVector[i - 1][j - 1];
+            else
+                distanceVector[i][j] =
+                    std::min({distanceVector[i - 1][j],
+                              distanceVector[i][j - 1],
+                              distanceVector[i - 1][j - 1]}) +
+                    1;
+        }
+    }
+
+    return static_cast<size_t>(distanceVector[x][y]) <= max_distance;
+}
+
+//------------------------------------------------------------------------
+int main()
+{
+    constexpr size_t NUM_WORDS = 1000000;
+
+    std::mt19937 rng(42);
+    const std::string query = "transcript";
+
+    // Random words, every 100th one edited twice from the query
+    std::vector<std::string> words(NUM_WORDS);
+    for (size_t i = 0; i < NUM_WORDS; ++i)
+    {
+        auto& word = words[i];
+        if (i % 100 == 0)
+        {
+            word = i % 200 == 0 ? "transcripts" : "transkripts";
+            continue;
+        }
+
+        word.resize(1 + rng() % 10);
+        for (auto& c : word)
+            c = static_cast<char>('a' + rng() % 26);
+    }
+    for (size_t max_distance = 1; max_distance <= 2; ++max_distance)
+    {
+        auto start     = Clock::now();
+        size_t matches = 0;
+        for (const auto& word : words)
+            matches += matrix_is_match(word, query, max_distance);
+        std::cout << "matrix       d <= " << max_distance << ": "
+                  << elapsed_ms(start) << " ms, " << matches << " matches\n";
+
+        start   = Clock::now();
+        matches = 0;
+        for (const auto& word : words)
+            matches += StringMatcher::boundedEditDistance(word, query,
+                                                          max_distance)
+                           .has_value();
+        std::cout << "bit-parallel d <= " << max_distance << ": "
+                  << elapsed_ms(start) << " ms, " << matches << " matches\n";
+    }
+
+    return 0;
+}
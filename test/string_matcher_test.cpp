@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------
+// Copyright (c) 2023-present, WordifyOrg.
+//------------------------------------------------------------------------
+
+// Randomized equivalence test of the StringMatcher edit distance kernels
+// against the plain DP matrix. Covers the bit-parallel kernel (up to 64
+// bytes), the banded fallback and the early exit of the bounded variant.
+//
+// g++ -O2 -std=c++17 -I ../source string_matcher_test.cpp
+//     ../source/string_matcher.cpp ../source/double_metaphone.cpp
+//     ../source/stemmer.cpp
+
+#include "string_matcher.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mam;
+
+//------------------------------------------------------------------------
+static auto reference_distance(const std::string& s0, const std::string& s1)
+    -> size_t
+{
+    std::vector<std::vector<size_t>> d(s0.size() + 1,
+                                       std::vector<size_t>(s1.size() + 1, 0));
+    for (size_t i = 0; i <= s0.size(); ++i)
+        d[i][0] = i;
+    for (size_t j = 0; j <= s1.size(); ++j)
+        d[0][j] = j;
+
+    for (size_t i = 1; i <= s0.size(); ++i)
+    {
+        for (size_t j = 1; j <= s1.size(); ++j)
+        {
+            if (s0[i - 1] == s1[j - 1])
+                d[i][j] = d[i - 1][j - 1];
+            else
+                d[i][j] =
+                    std::min({d[i - 1][j], d[i][j - 1], d[i - 1][j - 1]}) + 1;
+        }
+    }
+
+    return d[s0.size()][s1.size()];
+}
+
+//------------------------------------------------------------------------
+static auto random_word(std::mt19937& rng, size_t max_length, char alphabet)
+    -> std::string
+{
+    std::string word(rng() % (max_length + 1), ' ');
+    for (auto& c : word)
+        c = static_cast<char>('a' + rng() % alphabet);
+
+    return word;
+}
+
+//------------------------------------------------------------------------
+static auto mutate(std::mt19937& rng, std::string word, size_t edits)
+    -> std::string
+{
+    for (size_t i = 0; i < edits; ++i)
+    {
+        const auto pos  = word.empty() ? 0 : rng() % word.size();
+        const auto c    = static_cast<char>('a' + rng() % 26);
+        const auto edit = rng() % 3;
+        if (edit == 0 || word.empty())
+            word.insert(word.begin() + pos, c);
+        else if (edit == 1)
+            word.erase(word.begin() + pos);
+        else
+            word[pos] = c;
+    }
+
+    return word;
+}
+
+//------------------------------------------------------------------------
+int main()
+{
+    constexpr size_t NUM_PAIRS = 200000;
+
+    std::mt19937 rng(42);
+    size_t failures = 0;
+    for (size_t n = 0; n < NUM_PAIRS; ++n)
+    {
+        // Short words around the 64 byte border and a few long ones
+        const size_t max_length = n % 10 == 0 ? 200 : 70;
+        const char alphabet     = n % 2 == 0 ? 4 : 26;
+        const auto s0           = random_word(rng, max_length, alphabet);
+        const auto s1 = n % 3 == 0 ? random_word(rng, max_length, alphabet)
+                                   : mutate(rng, s0, rng() % 5);
+
+        const auto expected = reference_distance(s0, s1);
+        const auto actual   = StringMatcher::editDistance(s0, s1);
+        if (actual != expected)
+        {
+            std::cout << "editDistance(\"" << s0 << "\", \"" << s1
+                      << "\") = " << actual << ", expected " << expected
+                      << "\n";
+            ++failures;
+        }
+
+        for (size_t max_distance = 0; max_distance <= 4; ++max_distance)
+        {
+            const auto bounded =
+                StringMatcher::boundedEditDistance(s0, s1, max_distance);
+            const bool ok = expected <= max_distance
+                                ? bounded && *bounded == expected
+                                : !bounded;
+            if (!ok)
+            {
+                std::cout << "boundedEditDistance(\"" << s0 << "\", \"" << s1
+                          << "\", " << max_distance << ") is wrong, expected "
+                          << expected << "\n";
+                ++failures;
+            }
+        }
+    }
+
+    std::cout << (failures == 0 ? "OK" : "FAILED") << ", " << NUM_PAIRS
+              << " pairs, " << failures << " failures\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------
+// Copyright (c) 2023-present, WordifyOrg.
+//------------------------------------------------------------------------
+
+// Microbenchmark of TimelineIndex with 1M words spread over 100 regions.
+//
+// g++ -O2 -std=c++17 -I ../source timeline_index_benchmark.cpp
+//     ../source/timeline_index.cpp
+
+#include "timeline_index.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace mam;
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------
+static auto elapsed_us(Clock::time_point start) -> double
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start)
+        .count();
+}
+
+//------------------------------------------------------------------------
+int main()
+{
+    constexpr size_t NUM_REGIONS      = 100;
+    constexpr size_t WORDS_PER_REGION = 10000;
+    constexpr size_t NUM_QUERIES      = 100000;
+    constexpr double WORD_DURATION    = 0.3;
+
+    std::mt19937 rng(42);
+    TimelineIndex index;
+
+    auto start = Clock::now();
+    for (size_t r = 0; r < NUM_REGIONS; r++)
+    {
+        TimelineIndex::Entries entries;
+        entries.reserve(WORDS_PER_REGION);
+        const auto region_offset = static_cast<double>(r) * 3000.;
+        for (size_t w = 0; w < WORDS_PER_REGION; w++)
+        {
+            const auto begin = region_offset + static_cast<double>(w) * 0.3;
+            entries.push_back({begin, begin + WORD_DURATION, 0, w});
+        }
+        index.update_region(r, std::move(entries));
+    }
+    std::cout << "build " << index.size() << " words: " << elapsed_us(start)
+              << " us\n";
+
+    const auto project_end = static_cast<double>(NUM_REGIONS) * 3000.;
+    std::uniform_real_distribution<double> dist(0., project_end);
+
+    size_t hits = 0;
+    start       = Clock::now();
+    for (size_t i = 0; i < NUM_QUERIES; i++)
+        index.for_each_at(dist(rng), [&](const auto&) { hits++; });
+    std::cout << "point query: " << elapsed_us(start) / NUM_QUERIES
+              << " us/query, " << hits << " hits\n";
+
+    hits  = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < NUM_QUERIES; i++)
+    {
+        const auto t0 = dist(rng);
+        index.for_each_in(t0, t0 + 10., [&](const auto&) { hits++; });
+    }
+    std::cout << "range query (10 s): " << elapsed_us(start) / NUM_QUERIES
+              << " us/query, " << hits << " hits\n";
+
+    start = Clock::now();
+    TimelineIndex::Entries entries;
+    for (size_t w = 0; w < WORDS_PER_REGION; w++)
+    {
+        const auto begin = static_cast<double>(w) * 0.3 + 1.;
+        entries.push_back({begin, begin + WORD_DURATION, 0, w});
+    }
+    index.update_region(NUM_REGIONS / 2, std::move(entries));
+    std::cout << "update one region: " << elapsed_us(start) << " us\n";
+
+    return 0;
+}